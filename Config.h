@@ -9,13 +9,15 @@
 #define MENU_PVP        1
 #define MENU_AI_EASY    2
 #define MENU_AI_HARD    3
-#define MENU_SCORE      4
-#define MENU_EXIT       5
+#define MENU_AI_EXPERT  4
+#define MENU_SCORE      5
+#define MENU_EXIT       6
 
 /* Game modes */
 #define MODE_PVP        0
 #define MODE_AI_EASY    1
 #define MODE_AI_HARD    2
+#define MODE_AI_EXPERT  3    /* negamax alpha-beta search */
 
 /* Game actions returned by read_game_action() */
 #define ACT_QUIT       -1    /* Q */
@@ -1,22 +1,45 @@
 #include <stdio.h>
-#include <conio.h>
+#include <stdlib.h>
 #include <time.h>
 #include "Game_config.h"
+#include "Game_board.h"
+#include "Game_search.h"
+#include "Game_book.h"
+#include "Game_ai.h"
+#include "Game_geometry.h"
+#include "Game_time.h"
+
+
+// ===== Board geometry ======
+//
+// The engine (board_t, search, book, endgame database) is compiled for
+// COLS x ROWS. Any other size is played on its Game_geometry kernel: the game
+// keeps the move list, the kernel rules on it and picks the AI moves.
+
+static const geo_kernel_t* game_geo = NULL;   // Kernel of a non-build size (NULL - the build size, full engine)
+static int game_cols = COLS;                  // Size of the board being played
+static int game_rows = ROWS;
+
+int game_set_board(int cols, int rows) {   // { cols/rows - board size }
+    // Selects the board size of the next games. Returns 0 if no kernel was built for it.
+    const geo_kernel_t* k = geo_kernel(cols, rows);
+
+    if (cols == COLS && rows == ROWS) k = NULL;
+    else if (!k) return 0;
+
+    game_geo = k;
+    game_cols = cols;
+    game_rows = rows;
+    return 1;
+}
 
+/*=======*/
 
-// ===== UI helper functions ======
-
-// ------ Line clearing ----
-static void clear_line(void) {
-    // Clears the current console line
-    printf("\x1b[2K");
-}
 
-// ------ Cursor movements ----
-static void cursor_goto(int row, int col) {   // { row - needed row, col - needed column }
-    // Moves the cursor to board [row, col]
-    printf("\x1b[%d;%dH", row, col);
-}
+// ===== UI helper functions ======
+//
+// All drawing goes into the frame buffer of Game_UI.c; nothing reaches the
+// terminal until the frame is flushed.
 
 // ------ Board cell to screen coordinate mapping ----
 static int cell_screen_row(int r) {   // { r - board row index }
@@ -35,88 +58,123 @@ static void draw_turn(int player) {   // { player - current player (1/2) }
     cursor_goto(TURN_ROW + 1, 1);
     clear_line();
 
-    printf(ANSI_FG_CYAN "Currently playing: ");
-    if (player == 1) printf(ANSI_FG_RED ANSI_BRIGHT "Player 1" ANSI_RESET);
-    else             printf(ANSI_FG_YELLOW ANSI_BRIGHT "Player 2" ANSI_RESET);
-
-    fflush(stdout);
+    ui_printf(ANSI_FG_CYAN "Currently playing: ");
+    if (player == 1) ui_printf(ANSI_FG_RED ANSI_BRIGHT "Player 1" ANSI_RESET);
+    else             ui_printf(ANSI_FG_YELLOW ANSI_BRIGHT "Player 2" ANSI_RESET);
 }
 
 static void draw_message(const char* msg) {   // { msg - message to print (can be NULL) }
-    // Prints a message line (empty if msg is NULL)
-    cursor_goto(MSG_ROW, 1);
+    // Prints a message line (empty if msg is NULL); it moves down with taller boards
+    cursor_goto(MSG_ROW + (game_rows - ROWS) * CELL_H, 1);
     clear_line();
 
-    printf(ANSI_FG_GRAY "%s" ANSI_RESET, (msg) ? (msg) : (""));
-    fflush(stdout);
+    ui_printf(ANSI_FG_GRAY "%s" ANSI_RESET, (msg) ? (msg) : (""));
+}
+
+static void draw_search_stats(const search_result_t* res) {   // { res - last AI search }
+    // Prints depth, nodes, time and transposition table hit rate of the last AI move
+    char line[128];
+    double hit = (res->tt_probes) ? (100.0 * (double)res->tt_hits / (double)res->tt_probes) : (0.0);
+
+    if (res->from_book) {
+        draw_message("AI: opening book move");
+        return;
+    }
+    if (res->from_pns) {
+        snprintf(line, sizeof(line), "AI: forced win proven by df-pn | %llu nodes | %.0f ms",
+            (unsigned long long)res->nodes, res->ms);
+        draw_message(line);
+        return;
+    }
+
+    snprintf(line, sizeof(line), "AI: depth %d | %llu nodes | %d threads | %.0f ms | TT hit %.1f%%%s",
+        res->depth, (unsigned long long)res->nodes, res->threads, res->ms, hit,
+        (res->pondered) ? (" | ponder hit") : (""));
+    draw_message(line);
+}
+
+static void draw_mcts_stats(const mcts_result_t* res) {   // { res - last MCTS search }
+    // Prints simulations, simulations per second, tree size and the expected result of the MCTS move
+    char line[128];
+
+    snprintf(line, sizeof(line), "AI: MCTS %llu sims | %.0fk sims/s | %d threads | %.0f ms | win %.0f%%%s",
+        (unsigned long long)res->sims, (res->ms > 0) ? ((double)res->sims / res->ms) : (0.0),
+        res->threads, res->ms, 100.0 * res->value,
+        (res->arena_full) ? (" | tree full") : (""));
+    draw_message(line);
 }
 
 // ------ Board frame rendering ----
-static void draw_board_frame_static(int mode) {   // { mode - 0 PvP, 1 AI EZ, 2 AI HARD }
+static void draw_board_frame_static(int mode) {   // { mode - MODE_* game mode }
     // Draws the board frame and the controls text (static UI)
 
     char* mode_name;
 
-    if (!mode) mode_name = "\x1b[32mPvP";
-    else mode_name = (mode == 1) ? ("\x1b[37mAI lvl \x1b[33mEZ") : ("\x1b[37mAI lvl \x1b[31mHARD");
+    switch (mode) {
+    case MODE_PVP:       mode_name = "\x1b[32mPvP"; break;
+    case MODE_AI_EASY:   mode_name = "\x1b[37mAI lvl \x1b[33mEZ"; break;
+    case MODE_AI_HARD:   mode_name = "\x1b[37mAI lvl \x1b[31mHARD"; break;
+    case MODE_AI_MCTS:   mode_name = "\x1b[37mAI lvl \x1b[36mMCTS"; break;
+    default:             mode_name = "\x1b[37mAI lvl \x1b[35mEXPERT"; break;
+    }
 
     cursor_goto(TURN_ROW, 1);
-    printf(ANSI_FG_CYAN "Game mode: %s \n\n", mode_name);
+    ui_printf(ANSI_FG_CYAN "Game mode: %s " ANSI_FG_GRAY "%dx%d\n\n", mode_name, game_cols, game_rows);
 
     cursor_goto(BOARD_TOP_ROW, BOARD_LEFT_COL);
 
     /* Top border */
-    printf(ANSI_FG_GRAY);
-    printf("+");
+    ui_printf(ANSI_FG_GRAY);
+    ui_printf("+");
 
     /* Board body */
-    for (int c = 0; c < COLS; c++) printf("---+");
+    for (int c = 0; c < game_cols; c++) ui_printf("---+");
 
     /* Rows */
-    for (int r = 0; r < ROWS; r++) {
+    for (int r = 0; r < game_rows; r++) {
 
         /* Cell line */
         cursor_goto(BOARD_TOP_ROW + 1 + r * 2, BOARD_LEFT_COL);
-        printf(ANSI_FG_GRAY "|");
-        for (int c = 0; c < COLS; c++) printf("   |");
-        printf(ANSI_RESET);
+        ui_printf(ANSI_FG_GRAY "|");
+        for (int c = 0; c < game_cols; c++) ui_printf("   |");
+        ui_printf(ANSI_RESET);
 
         /* Separator */
         cursor_goto(BOARD_TOP_ROW + 2 + r * 2, BOARD_LEFT_COL);
-        printf(ANSI_FG_GRAY "+");
-        for (int c = 0; c < COLS; c++) printf("---+");
-        printf(ANSI_RESET);
+        ui_printf(ANSI_FG_GRAY "+");
+        for (int c = 0; c < game_cols; c++) ui_printf("---+");
+        ui_printf(ANSI_RESET);
     }
 
     cursor_goto(ARROW_ROW + 3, 0);
-    printf(ANSI_FG_GRAY "\nLEFT/RIGHT - move\n\nENTER/SPACE - drop chip\n\nr - reset\n\nESC - quit");
-    fflush(stdout);
+    ui_printf(ANSI_FG_GRAY "\nLEFT/RIGHT - move\n\nENTER/SPACE - drop chip\n\nr - reset\n\nu / y - undo / redo\n\nESC - quit");
 }
 
 // ------ Board cells rendering ----
-static void draw_cell(int board[ROWS][COLS], int r, int c) {   // { board - board matrix, r - row, c - col }
-    // Draws a single cell based on board value (0 empty, 1 P1, 2 P2)
-
-    int val = board[r][c];
+static void draw_chip(int r, int c, int val) {   // { r - row, c - col, val - 0 empty, 1 P1, 2 P2 }
+    // Draws a single cell
     int sr = cell_screen_row(r);
     int sc = cell_screen_col(c);
 
     cursor_goto(sr, sc);
 
     if (val == 1) {
-        printf(ANSI_FG_RED ANSI_BRIGHT " O " ANSI_RESET);
+        ui_printf(ANSI_FG_RED ANSI_BRIGHT " O " ANSI_RESET);
     }
     else if (val == 2) {
-        printf(ANSI_FG_YELLOW ANSI_BRIGHT " O " ANSI_RESET);
+        ui_printf(ANSI_FG_YELLOW ANSI_BRIGHT " O " ANSI_RESET);
     }
     else {
-        printf(ANSI_DIM " . " ANSI_RESET);
+        ui_printf(ANSI_DIM " . " ANSI_RESET);
     }
+}
 
-    fflush(stdout);
+static void draw_cell(const board_t* board, int r, int c) {   // { board - game board, r - row, c - col }
+    // Draws a single cell based on board value
+    draw_chip(r, c, board_cell(board, r, c));
 }
 
-static void draw_all_cells(int board[ROWS][COLS]) {   // { board - board matrix }
+static void draw_all_cells(const board_t* board) {   // { board - game board }
     // Draws all board cells (full refresh of chips)
     for (int r = 0; r < ROWS; r++) {
         for (int c = 0; c < COLS; c++) {
@@ -133,164 +191,361 @@ static void draw_arrow(int col, int on, int player) {   // { col - column index,
     cursor_goto(ARROW_ROW, ac);
 
     if (!on) {
-        printf(" ");
-        fflush(stdout);
+        ui_printf(" ");
         return;
     }
 
-    if (player == 1) printf(ANSI_FG_RED ANSI_BRIGHT "v" ANSI_RESET);
-    else             printf(ANSI_FG_YELLOW ANSI_BRIGHT "v" ANSI_RESET);
-
-    fflush(stdout);
+    if (player == 1) ui_printf(ANSI_FG_RED ANSI_BRIGHT "v" ANSI_RESET);
+    else             ui_printf(ANSI_FG_YELLOW ANSI_BRIGHT "v" ANSI_RESET);
 }
 
 /*=======*/
 
 
-// ===== Game logic functions ======
+// ===== Game animation functions ======
 
-// ------ Chip dropping ----
-static int drop_chip(int board[ROWS][COLS], int col, int player) {   // { board - board matrix, col - chosen column, player - 1/2 }
-    // Drops a chip into the requested column. Returns landing row, or -1 if column is full.
-    for (int r = ROWS - 1; r >= 0; r--) {
-        if (board[r][col] == 0) {
-            board[r][col] = player;
-            return r;
+// ------ Falling chip animation ----
+static void animate_fall(int col, int to_row, int player) {   // { col - column, to_row - final row, player - 1/2 }
+    // Temporarily draws a falling chip until it reaches the final row. A key press skips the rest.
+    ui_timer_t timer;
+    int skip = 0;
+
+    ui_timer_start(&timer, 125);
+
+    for (int r = 0; r <= to_row; r++) {
+        int sr = cell_screen_row(r);
+        int sc = cell_screen_col(col);
+        cursor_goto(sr, sc);
+
+        if (player == 1) ui_printf(ANSI_FG_RED ANSI_BRIGHT " O " ANSI_RESET);
+        else             ui_printf(ANSI_FG_YELLOW ANSI_BRIGHT " O " ANSI_RESET);
+
+        skip = ui_timer_wait(&timer);   /* Flushes this animation frame */
+
+        if (r != to_row) {
+            cursor_goto(sr, sc);
+            ui_printf(ANSI_DIM " . " ANSI_RESET);
         }
+        if (skip) break;
     }
-    return -1;
+
+    /* The chip stays in its final cell */
+    draw_chip(to_row, col, player);
 }
 
-// ------ Win detection helpers ----
-static int count_dir(int board[ROWS][COLS], int r, int c, int dr, int dc, int player) {   // { dr/dc - direction step }
-    // Counts same-player chips in a direction from (r,c) (excluding starting cell)
-    int cnt = 0;
-    r += dr; c += dc;
-    while (r >= 0 && r < ROWS && c >= 0 && c < COLS && board[r][c] == player) {
-        cnt++;
-        r += dr; c += dc;
-    }
-    return cnt;
+/*=======*/
+
+
+// ===== AI settings ======
+
+// ------ AI shared state ----
+static tt_t* ai_tt = NULL;                 // Transposition table for the search based AI (allocated by ai_init)
+static int ai_time_ms = AI_TIME_MS_DEFAULT;  // Per-move budget of the search based AI
+static int ai_threads = 1;                   // Search workers (set by ai_set_threads)
+static book_t* ai_book = NULL;               // Memory-mapped opening book (NULL - none)
+static egdb_t* ai_egdb = NULL;               // Memory-mapped endgame database of the HARD AI (NULL - none)
+static pns_t* ai_pns = NULL;                 // df-pn table of the EXPERT AI (NULL - it only searches)
+static rng_t ai_rng;                         // Random source of the EZ AI (seeded by ai_init)
+static int ai_ponder_on = 0;                 // 1 - EXPERT keeps searching during the human's turn
+static ai_ponder_t ai_ponder;                // Background search state (ai_init)
+static mcts_t* ai_mcts = NULL;               // Node arena of the MCTS AI (NULL - MCTS mode falls back to the search)
+
+int ai_init(int tt_mb, int huge_pages) {   // { tt_mb - table size in MB, huge_pages - 1 try large pages }
+    // Allocates the AI transposition table once at startup. Returns 0 on failure.
+    rng_seed(&ai_rng, (uint64_t)time(NULL));
+    ai_ponder_init(&ai_ponder);
+
+    mcts_destroy(ai_mcts);
+    ai_mcts = mcts_create(MCTS_DEFAULT_NODES);   /* Pages are only touched as the tree grows */
+
+    pns_destroy(ai_pns);
+    ai_pns = pns_create(PNS_DEFAULT_MB);         /* Optional: without it EXPERT just searches */
+
+    tt_destroy(ai_tt);
+    ai_tt = tt_create((size_t)tt_mb, huge_pages);
+    return ai_tt != NULL;
 }
 
-static int check_win(int board[ROWS][COLS], int r, int c, int player) {   // { r/c - last placed position }
-    // Checks if the last move at (r,c) created a 4-in-a-row
-    int horiz = 1 + count_dir(board, r, c, 0, -1, player) + count_dir(board, r, c, 0, 1, player);
-    int vert = 1 + count_dir(board, r, c, -1, 0, player) + count_dir(board, r, c, 1, 0, player);
-    int diag1 = 1 + count_dir(board, r, c, -1, -1, player) + count_dir(board, r, c, 1, 1, player);
-    int diag2 = 1 + count_dir(board, r, c, -1, 1, player) + count_dir(board, r, c, 1, -1, player);
+void ai_set_move_time(int ms) {   // { ms - per-move budget in milliseconds }
+    // Sets how long the search based AI may think per move
+    ai_time_ms = (ms > 0) ? (ms) : (1);
+}
 
-    return (horiz >= 4 || vert >= 4 || diag1 >= 4 || diag2 >= 4);
+void ai_set_threads(int threads) {   // { threads - worker count, 0 - one per logical CPU }
+    // Sets how many Lazy SMP workers the search based AI runs
+    if (threads <= 0) threads = search_cpu_count();
+    ai_threads = (threads > SEARCH_MAX_THREADS) ? (SEARCH_MAX_THREADS) : (threads);
 }
 
-static int check_draw(int board[ROWS][COLS]) {   // { board - board matrix }
-    // Returns 1 if the board is full (draw), else 0
-    for (int c = 0; c < COLS; c++) {
-        if (board[0][c] == 0) return 0;
-    }
-    return 1;
+void ai_set_ponder(int on) {   // { on - 1 ponder during the human's turn }
+    // Lets the EXPERT AI search on the human's time
+    ai_ponder_on = on;
+}
+
+int ai_open_book(const char* path) {   // { path - book file from Game_book_gen }
+    // Maps the opening book; its pages are only read when a probe needs them. Returns 0 if missing/invalid.
+    book_close(ai_book);
+    ai_book = book_open(path);
+    return ai_book != NULL;
+}
+
+int ai_open_egdb(const char* path) {   // { path - database file from Game_egdb_gen }
+    // Maps the endgame database the HARD AI probes near the end of a game. Returns 0 if missing/invalid.
+    egdb_close(ai_egdb);
+    ai_egdb = egdb_open(path);
+    return ai_egdb != NULL;
+}
+
+void ai_shutdown(void) {
+    // Releases the AI transposition table, the opening book and the endgame database
+    ai_ponder_stop(&ai_ponder);
+    tt_destroy(ai_tt);
+    ai_tt = NULL;
+    mcts_destroy(ai_mcts);
+    ai_mcts = NULL;
+    pns_destroy(ai_pns);
+    ai_pns = NULL;
+    book_close(ai_book);
+    ai_book = NULL;
+    egdb_close(ai_egdb);
+    ai_egdb = NULL;
 }
 
 /*=======*/
 
 
-// ===== Game animation functions ======
+// ===== Games on other board sizes ======
+//
+// The position is only the move list; the kernel's play() tells whether it
+// is legal, won or drawn, and the heights are kept here for drawing. EZ keeps
+// its random move, HARD runs best_move() at AI_HARD_DEPTH, EXPERT and MCTS
+// deepen it until a quarter of the move time is gone (the next depth costs
+// several times the last one). Book, endgame database and ponder are built
+// for COLS x ROWS and sit these games out.
+
+typedef struct {
+    uint8_t moves[GEO_MAX_COLS * GEO_MAX_ROWS];   // 0-based columns from the empty board
+    int n;                                        // Moves on the board
+    int last;                                     // Moves redo can replay up to
+    int height[GEO_MAX_COLS];                     // Chips per column
+} geo_game_t;
+
+// ------ Moves ----
+static int geo_game_play(geo_game_t* g, int col) {   // { col - column }
+    // Plays col for the side to move and forgets the redo moves. Landing row or -1 if full.
+    if (g->height[col] >= game_rows) return -1;
+
+    g->moves[g->n++] = (uint8_t)col;
+    g->last = g->n;
+    return game_rows - ++g->height[col];
+}
 
-// ------ Falling chip animation ----
-static void animate_fall(int board[ROWS][COLS], int col, int to_row, int player) {   // { col - column, to_row - final row, player - 1/2 }
-    // Temporarily draws a falling chip until it reaches the final row
+static int geo_game_undo(geo_game_t* g) {
+    // Takes back the last move. Its column, or -1 if none.
+    if (!g->n) return -1;
 
-    for (int r = 0; r <= to_row; r++) {
-        int sr = cell_screen_row(r);
-        int sc = cell_screen_col(col);
-        cursor_goto(sr, sc);
+    int col = g->moves[--g->n];
+    g->height[col]--;
+    return col;
+}
 
-        if (player == 1) printf(ANSI_FG_RED ANSI_BRIGHT " O " ANSI_RESET);
-        else             printf(ANSI_FG_YELLOW ANSI_BRIGHT " O " ANSI_RESET);
+static int geo_game_redo(geo_game_t* g) {
+    // Replays the next undone move. Its column, or -1 if none.
+    if (g->n >= g->last) return -1;
 
-        fflush(stdout);
-        delay_ms(125);
+    int col = g->moves[g->n++];
+    g->height[col]++;
+    return col;
+}
 
-        if (r != to_row) {
-            cursor_goto(sr, sc);
-            printf(ANSI_DIM " . " ANSI_RESET);
-            fflush(stdout);
+static void geo_draw_all_cells(const geo_game_t* g) {
+    // Draws every cell from the move list (Player 1 makes the even moves)
+    int height[GEO_MAX_COLS] = { 0 };
+
+    for (int r = 0; r < game_rows; r++) {
+        for (int c = 0; c < game_cols; c++) draw_chip(r, c, 0);
+    }
+    for (int i = 0; i < g->n; i++) {
+        int c = g->moves[i];
+        draw_chip(game_rows - ++height[c], c, 1 + (i & 1));
+    }
+}
+
+// ------ AI ----
+static int geo_ai_move(const geo_game_t* g, int mode, char* line, size_t size) {   // { mode - MODE_*, line - out: stats message }
+    // Column of the AI move on the kernel
+    double start = time_now_ms();
+    uint64_t nodes = 0;
+    int score = 0;
+    int depth = 0;
+    int col = -1;
+
+    if (mode == MODE_AI_EASY) {
+        unsigned mask = 0;
+
+        for (int c = 0; c < game_cols; c++) mask |= (unsigned)(g->height[c] < game_rows) << c;
+        snprintf(line, size, "%s", "");
+        return rng_pick(&ai_rng, mask);
+    }
+
+    if (mode == MODE_AI_HARD) {
+        depth = AI_HARD_DEPTH;
+        col = game_geo->best_move(g->moves, g->n, depth, &score, &nodes);
+    }
+    else {
+        /* Every depth restarts from the root: the kernel has no table to carry over */
+        while (depth < game_cols * game_rows - g->n) {
+            uint64_t n = 0;
+            int s;
+            int c = game_geo->best_move(g->moves, g->n, depth + 1, &s, &n);
+
+            if (c < 0) break;
+            col = c;
+            score = s;
+            nodes += n;
+            depth++;
+            if (score >= GEO_SCORE_WIN - game_cols * game_rows || time_now_ms() - start >= ai_time_ms / 4.0) break;
         }
     }
 
-    /* Final cell draw uses board state */
-    draw_cell(board, to_row, col);
+    snprintf(line, size, "AI: %s kernel | depth %d | %llu nodes | %.0f ms%s", game_geo->name, depth,
+        (unsigned long long)nodes, time_now_ms() - start,
+        (score >= GEO_SCORE_WIN - game_cols * game_rows) ? (" | forced win") : (""));
+    return col;
 }
 
-/*=======*/
+// ------ Game loop ----
+static int start_game_geo(int mode) {   // { mode - MODE_* game mode }
+    // start_game() for a kernel geometry. Returns: -1 (quit), 0 (draw), 1 (player 1 win), 2 (player 2 win)
+    geo_game_t g = { { 0 }, 0, 0, { 0 } };
+    int cursor_col = game_cols / 2;
+    int player = 1;
 
+    clear_screen();
+    draw_turn(player);
+    draw_board_frame_static(mode);
+    geo_draw_all_cells(&g);
+    draw_arrow(cursor_col, 1, player);
 
-// ===== AI functions ======
+    draw_message(ANSI_FG_YELLOW "Good luck. Try not to embarrass yourself. (Press SPACE to start)");
 
-// ------ AI random (EZ mode) ----
-static int ai_choose_column(int board[ROWS][COLS]) {   // { board - board matrix }
-    // Finds a random non-full column
-    int col;
     for (;;) {
-        col = rand() % COLS;
-        if (board[0][col] == 0) {
-            return col;
+        int ai_turn = (mode != MODE_PVP && player == 2);
+        int col = cursor_col;
+        int k, row, state;
+        char line[128] = "";
+
+        // ------ AI turn / human input ----
+        if (ai_turn) {
+            ui_flush();   /* Show the human move before the AI thinks */
+            col = geo_ai_move(&g, mode, line, sizeof(line));
+            k = K_ENTER;
+
+            draw_arrow(cursor_col, 0, player);
+            cursor_col = col;
+            draw_arrow(cursor_col, 1, player);
+        }
+        else {
+            k = read_key();
         }
-    }
-}
 
-// ------ AI hard mode ----
-static int ai_choose_column_hard(int board[ROWS][COLS], int ai_player) {   // { board - board matrix, ai_player - AI player id (1/2) }
-    // Hard AI: win if possible, block human win, otherwise prefer center columns
+        if (k == K_ENTER) {
+            row = geo_game_play(&g, col);
+            if (row == -1) {
+                draw_message(ANSI_FG_RED "Column full. Pick another one." ANSI_RESET);
+                continue;
+            }
 
-    int human = (ai_player == 1) ? 2 : 1;
+            animate_fall(col, row, player);
+            state = game_geo->play(g.moves, g.n);
 
-    /* 1) WIN NOW */
-    for (int c = 0; c < COLS; c++) {
-        if (board[0][c] != 0) continue;
+            if (state == GEO_WON) {
+                draw_turn(player);
+                if (ai_turn)          draw_message(ANSI_FG_GREEN "You lose... Press any key...");
+                else if (player == 1) draw_message(ANSI_FG_GREEN "Player 1 wins! Press any key...");
+                else                  draw_message(ANSI_FG_GREEN "Player 2 wins! Press any key...");
+                ui_getch();
+                return player;
+            }
 
-        int r;
-        for (r = ROWS - 1; r >= 0; r--) {
-            if (board[r][c] == 0) break;
-        }
-        if (r < 0) continue;
+            if (state == GEO_DRAW) {
+                draw_message(ANSI_FG_YELLOW "Draw! Press any key...");
+                ui_getch();
+                return 0;
+            }
 
-        board[r][c] = ai_player;
-        if (check_win(board, r, c, ai_player)) {
-            board[r][c] = 0;
-            return c;
+            player = (player == 1) ? 2 : 1;
+            draw_turn(player);
+            draw_arrow(cursor_col, 1, player);
+            draw_message(line);
+            continue;
         }
-        board[r][c] = 0;
-    }
 
-    /* 2) BLOCK HUMAN WIN */
-    for (int c = 0; c < COLS; c++) {
-        if (board[0][c] != 0) continue;
+        // ------ Movement / control keys ----
+        switch (k) {
 
-        int r;
-        for (r = ROWS - 1; r >= 0; r--) {
-            if (board[r][c] == 0) break;
-        }
-        if (r < 0) continue;
+        case K_LEFT:
+            if (cursor_col > 0) {
+                draw_arrow(cursor_col, 0, player);
+                cursor_col--;
+                draw_arrow(cursor_col, 1, player);
+            }
+            break;
+
+        case K_RIGHT:
+            if (cursor_col < game_cols - 1) {
+                draw_arrow(cursor_col, 0, player);
+                cursor_col++;
+                draw_arrow(cursor_col, 1, player);
+            }
+            break;
+
+        case K_RESET:
+            g.n = 0;
+            g.last = 0;
+            for (int c = 0; c < game_cols; c++) g.height[c] = 0;
 
-        board[r][c] = human;
-        if (check_win(board, r, c, human)) {
-            board[r][c] = 0;
-            return c;
+            player = 1;
+            cursor_col = game_cols / 2;
+
+            clear_screen();
+            draw_turn(player);
+            draw_board_frame_static(mode);
+            geo_draw_all_cells(&g);
+            draw_arrow(cursor_col, 1, player);
+            draw_message("The game has been reset.");
+            break;
+
+        case K_UNDO:
+        case K_REDO: {
+            /* Against the AI one step is the human move and the AI reply, so the human stays to move */
+            int plies = (mode == MODE_PVP) ? 1 : 2;
+            int done = 0;
+
+            for (; done < plies; done++) {
+                int c = (k == K_UNDO) ? geo_game_undo(&g) : geo_game_redo(&g);
+                if (c < 0) break;
+
+                /* Only the cell that changed is redrawn: the emptied one, or the one filled again */
+                if (k == K_UNDO) draw_chip(game_rows - 1 - g.height[c], c, 0);
+                else             draw_chip(game_rows - g.height[c], c, 1 + ((g.n - 1) & 1));
+            }
+
+            draw_arrow(cursor_col, 0, player);
+            player = 1 + (g.n & 1);
+            draw_turn(player);
+            draw_arrow(cursor_col, 1, player);
+
+            if (!done)             draw_message((k == K_UNDO) ? "Nothing to undo." : "Nothing to redo.");
+            else if (k == K_UNDO)  draw_message("Move taken back. (y - redo)");
+            else                   draw_message("Move replayed.");
+            break;
         }
-        board[r][c] = 0;
-    }
 
-    /* 3) FALLBACK: center-ish preference, otherwise random valid */
-    {
-        int pref[COLS] = { 3, 2, 4, 1, 5, 0, 6 };
-        for (int i = 0; i < COLS; i++) {
-            int c = pref[i];
-            if (board[0][c] == 0) return c;
+        case K_ESC:
+            return -1;
         }
     }
-
-    return 0;
 }
 
 /*=======*/
@@ -299,17 +554,21 @@ static int ai_choose_column_hard(int board[ROWS][COLS], int ai_player) {   // {
 // ===== Game entry point ======
 
 // ------ Start game loop ----
-int start_game(int mode) {   // { mode - 0 PvP, 1 AI EZ, 2 AI HARD }
+int start_game(int mode) {   // { mode - MODE_* game mode }
     // Main game loop. Returns: -1 (quit), 0 (draw), 1 (player 1 win), 2 (player 2 win)
 
-    int board[ROWS][COLS] = { 0 };
+    board_history_t hist;   // Position plus the moves that undo / redo walk through
     int cursor_col = COLS / 2;
     int player = 1;
 
+    if (game_geo) return start_game_geo(mode);   /* Other board sizes play on their kernel */
+
+    board_history_reset(&hist);
+
     clear_screen();
     draw_turn(player);
     draw_board_frame_static(mode);
-    draw_all_cells(board);
+    draw_all_cells(&hist.board);
 
     /* Arrow initial */
     draw_arrow(cursor_col, 1, player);
@@ -319,34 +578,63 @@ int start_game(int mode) {   // { mode - 0 PvP, 1 AI EZ, 2 AI HARD }
     for (;;) {
 
         // ------ AI turn handling ----
-        if (mode > 0 && player == 2) {
-            int col = (mode == 1) ? (ai_choose_column(board)) : (ai_choose_column_hard(board, 2));
-            int row = drop_chip(board, col, player);
+        if (mode != MODE_PVP && player == 2) {
+            search_params_t params = { SEARCH_MAX_DEPTH, ai_time_ms, ai_threads, NULL, 0 };
+            mcts_params_t mparams = { ai_time_ms, ai_threads, 0, 0 };
+            search_result_t res = { 0 };
+            mcts_result_t mres;
+            int col = -1;
+
+            ui_flush();   /* Show the human move before the AI thinks */
+
+            switch (mode) {
+            case MODE_AI_EASY: col = ai_choose_column(&hist.board, &ai_rng); break;
+            case MODE_AI_HARD: col = ai_choose_column_hard(&hist.board, 2, ai_egdb); break;
+            case MODE_AI_MCTS:
+                if (ai_mcts) {
+                    col = ai_choose_column_mcts(&hist.board, ai_mcts, &mparams, &mres);
+                    break;
+                }
+                /* No arena: play the search instead */
+                col = ai_choose_column_expert(&hist.board, &params, ai_tt, ai_book, ai_pns, &res);
+                break;
+            default:
+                /* A pondered guess of this human move answers at once; otherwise search (from a warm table) */
+                col = ai_ponder_finish(&ai_ponder, &hist.board, ai_time_ms, &res);
+                if (col < 0) col = ai_choose_column_expert(&hist.board, &params, ai_tt, ai_book, ai_pns, &res);
+                break;
+            }
+            int row = board_history_play(&hist, col);
 
             draw_arrow(cursor_col, 0, player);
             cursor_col = col;
             draw_arrow(cursor_col, 1, player);
 
-            animate_fall(board, col, row, player);
+            animate_fall(col, row, player);
 
-            if (check_win(board, row, cursor_col, player)) {
+            if (board_has_won(&hist.board, player)) {
                 draw_turn(player);
                 if (player == 1) draw_message(ANSI_FG_GREEN "You won! Press any key...");
                 else             draw_message(ANSI_FG_GREEN "You lose... Press any key...");
-                _getch();
+                ui_getch();
                 return player;
             }
 
-            if (check_draw(board)) {
+            if (board_is_full(&hist.board)) {
                 draw_message(ANSI_FG_YELLOW "Draw! Press any key...");
-                _getch();
+                ui_getch();
                 return 0;
             }
 
             player = 1;
             draw_turn(player);
             draw_arrow(cursor_col, 1, player);
-            draw_message("");
+            if (mode == MODE_AI_EXPERT)                draw_search_stats(&res);
+            else if (mode == MODE_AI_MCTS && ai_mcts)  draw_mcts_stats(&mres);
+            else if (mode == MODE_AI_MCTS)             draw_search_stats(&res);
+            else                                       draw_message("");
+
+            if (mode == MODE_AI_EXPERT && ai_ponder_on) ai_ponder_start(&ai_ponder, &hist.board, &params, ai_tt, ai_book);
             continue;
         }
 
@@ -354,25 +642,27 @@ int start_game(int mode) {   // { mode - 0 PvP, 1 AI EZ, 2 AI HARD }
         int k = read_key();
 
         if (k == K_ENTER) {
-            int row = drop_chip(board, cursor_col, player);
+            int row = board_history_play(&hist, cursor_col);
             if (row == -1) {
                 draw_message(ANSI_FG_RED "Column full. Pick another one." ANSI_RESET);
                 continue;
             }
 
-            animate_fall(board, cursor_col, row, player);
+            animate_fall(cursor_col, row, player);
 
-            if (check_win(board, row, cursor_col, player)) {
+            if (board_has_won(&hist.board, player)) {
+                ai_ponder_stop(&ai_ponder);
                 draw_turn(player);
                 if (player == 1) draw_message(ANSI_FG_GREEN "Player 1 wins! Press any key...");
                 else             draw_message(ANSI_FG_GREEN "Player 2 wins! Press any key...");
-                _getch();
+                ui_getch();
                 return player;
             }
 
-            if (check_draw(board)) {
+            if (board_is_full(&hist.board)) {
+                ai_ponder_stop(&ai_ponder);
                 draw_message(ANSI_FG_YELLOW "Draw! (You both suck) Press any key...");
-                _getch();
+                ui_getch();
                 return 0;
             }
 
@@ -402,9 +692,8 @@ int start_game(int mode) {   // { mode - 0 PvP, 1 AI EZ, 2 AI HARD }
             break;
 
         case K_RESET:
-            for (int r = 0; r < ROWS; r++)
-                for (int c = 0; c < COLS; c++)
-                    board[r][c] = 0;
+            ai_ponder_stop(&ai_ponder);
+            board_history_reset(&hist);
 
             player = 1;
             cursor_col = COLS / 2;
@@ -412,12 +701,40 @@ int start_game(int mode) {   // { mode - 0 PvP, 1 AI EZ, 2 AI HARD }
             clear_screen();
             draw_turn(player);
             draw_board_frame_static(mode);
-            draw_all_cells(board);
+            draw_all_cells(&hist.board);
             draw_arrow(cursor_col, 1, player);
             draw_message("The game has been reset.");
             break;
 
+        case K_UNDO:
+        case K_REDO: {
+            /* Against the AI one step is the human move and the AI reply, so the human stays to move */
+            int plies = (mode == MODE_PVP) ? 1 : 2;
+            int done = 0;
+
+            ai_ponder_stop(&ai_ponder);
+
+            for (; done < plies; done++) {
+                int col = (k == K_UNDO) ? board_history_undo(&hist) : board_history_redo(&hist);
+                if (col < 0) break;
+
+                /* Only the cell that changed is redrawn: the emptied one, or the one filled again */
+                draw_cell(&hist.board, (k == K_UNDO) ? board_landing_row(&hist.board, col) : ROWS - hist.board.height[col], col);
+            }
+
+            draw_arrow(cursor_col, 0, player);
+            player = board_player_to_move(&hist.board);
+            draw_turn(player);
+            draw_arrow(cursor_col, 1, player);
+
+            if (!done)             draw_message((k == K_UNDO) ? "Nothing to undo." : "Nothing to redo.");
+            else if (k == K_UNDO)  draw_message("Move taken back. (y - redo)");
+            else                   draw_message("Move replayed.");
+            break;
+        }
+
         case K_ESC:
+            ai_ponder_stop(&ai_ponder);
             return -1;
         }
     }
@@ -1,7 +1,19 @@
+#include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
-#include <conio.h>
-#include <time.h>
+#include <string.h>
 #include "Game_config.h"
+#include "Game_geometry.h"
+#include "Game_input.h"
+#include "Game_time.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define ui_write(buf, len) _write(1, (buf), (unsigned)(len))
+#else
+#include <unistd.h>
+#define ui_write(buf, len) write(1, (buf), (len))
+#endif
 
 
 // ===== UI static data ======
@@ -10,6 +22,8 @@ const char* options[MENU_OPTIONS] = {
     "Play PvP [I have friends]",
     "Play vs AI [EZ MODE]",
     "Play vs AI [HARD MODE]",
+    "Play vs AI [EXPERT MODE]",
+    "Play vs AI [MCTS MODE]",
     "Show games statistics",
     "How to play?",
     "Exit"
@@ -19,13 +33,443 @@ const char* options[MENU_OPTIONS] = {
 
 
 // ===== Utility timing functions ======
+//
+// Waits sleep the thread on the monotonic clock (no CPU is used while an
+// animation is waiting for its next frame).
 
 // ------ Delay handling ----
 void delay_ms(int ms) {   // { ms - delay time in milliseconds }
-    // Creates a blocking delay using CPU clock ticks
-    clock_t start = clock();
-    clock_t wait = (clock_t)((ms * (double)CLOCKS_PER_SEC) / 1000.0);
-    while ((clock() - start) < wait) {}
+    // Shows the pending frame, then sleeps for ms milliseconds
+    ui_flush();
+    time_sleep_ms(ms);
+}
+
+// ------ Frame timer ----
+void ui_timer_start(ui_timer_t* t, int period_ms) {   // { t - timer, period_ms - frame period }
+    // Starts a periodic timer; the first tick is one period from now
+    t->period_ms = period_ms;
+    t->next = time_now_ms() + period_ms;
+}
+
+int ui_timer_wait(ui_timer_t* t) {   // { t - running timer }
+    // Shows the pending frame and sleeps until the next tick. Ticks are absolute,
+    // so drawing time does not stretch the animation. Returns 1 early if a key is
+    // waiting (the key stays queued), so animations can be cut short.
+    double now;
+
+    ui_flush();
+    if (input_wait_pending(t->next)) return 1;
+
+    now = time_now_ms();
+    t->next += t->period_ms;
+    if (t->next < now) t->next = now;   /* Fell behind (slow terminal): do not burst to catch up */
+    return 0;
+}
+
+/*=======*/
+
+
+// ===== Frame buffer ======
+//
+// Everything drawn for one logical update is appended to a preallocated
+// buffer and reaches the terminal with a single write() when the frame is
+// flushed: explicitly, before a delay, or before waiting for a key.
+
+static char frame_buf[UI_FRAME_BYTES];
+static size_t frame_len = 0;
+static unsigned long frame_bytes = 0;    // Bytes of the frame being composed
+static unsigned long frame_writes = 0;   // Syscalls spent on the frame being composed
+static ui_frame_stats_t frame_stats = { 0 };
+static double input_mark = 0;            // Arrival time of the oldest key not on screen yet (0 - none)
+
+// ------ Raw output ----
+static void frame_emit(void) {
+    // Writes the buffered bytes to stdout (loops on partial writes)
+    size_t done = 0;
+
+    while (done < frame_len) {
+        long n = (long)ui_write(frame_buf + done, frame_len - done);
+        frame_writes++;
+        if (n <= 0) break;   /* Terminal gone: drop the frame */
+        done += (size_t)n;
+    }
+
+    frame_bytes += (unsigned long)frame_len;
+    frame_len = 0;
+}
+
+static void frame_put(const char* s, size_t n) {   // { s - bytes, n - count }
+    // Appends bytes that go to the terminal as they are
+    while (n) {
+        size_t room = sizeof(frame_buf) - frame_len;
+        size_t part = (n < room) ? (n) : (room);
+
+        memcpy(frame_buf + frame_len, s, part);
+        frame_len += part;
+        s += part;
+        n -= part;
+        if (frame_len == sizeof(frame_buf)) frame_emit();
+    }
+}
+
+static void frame_putc(char ch) {
+    frame_put(&ch, 1);
+}
+
+static void frame_putf(const char* fmt, ...) {   // { fmt - printf format }
+    // Formatted frame_put for short escape sequences
+    char tmp[32];
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = vsnprintf(tmp, sizeof(tmp), fmt, ap);
+    va_end(ap);
+    if (n > 0) frame_put(tmp, ((size_t)n < sizeof(tmp)) ? ((size_t)n) : (sizeof(tmp) - 1));
+}
+
+/*=======*/
+
+
+// ===== Shadow screen ======
+//
+// ui_printf output is not sent as is: a small VT interpreter replays it into
+// `screen_back` (what the program wants on screen). ui_flush compares that to
+// `screen_front` (what the terminal shows) and sends only the cells that
+// changed, reusing the cursor position and colors where it can.
+//
+// cell bits: 0..7 character | 8..15 foreground SGR | 16..23 background SGR | 24 bright | 25 dim
+// A space only keeps its background: it looks the same in any foreground.
+
+#define CELL_CH(c)      ((char)((c) & 0xFF))
+#define CELL_ATTR(c)    ((c) & 0xFFFFFF00u)
+#define CELL_FG(c)      (((c) >> 8) & 0xFF)
+#define CELL_BG(c)      (((c) >> 16) & 0xFF)
+#define CELL_BRIGHT     (1u << 24)
+#define CELL_DIM        (1u << 25)
+#define CELL_BLANK      ((uint32_t)' ')        // Space, default colors
+#define CELL_BG_MASK    (0xFFu << 16)
+#define ATTR_UNKNOWN    0xFFFFFFFFu            // Terminal colors not known yet
+
+static uint32_t screen_back[UI_SCREEN_ROWS][UI_SCREEN_COLS];
+static uint32_t screen_front[UI_SCREEN_ROWS][UI_SCREEN_COLS];
+static int screen_diff = 1;           // 0 - send ui_printf output unchanged (--full-redraw)
+static int front_valid = 0;           // 0 - terminal contents unknown (before the first clear)
+static int back_cleared = 0;          // 1 - a full clear was drawn since the last flush
+static int back_row = 0, back_col = 0;     // Virtual cursor, 0-based
+static uint32_t back_attr = 0;             // Current SGR state (attribute bits of a cell)
+static int term_row = -1, term_col = -1;   // Real cursor (-1 - unknown)
+static uint32_t term_attr = ATTR_UNKNOWN;  // Real SGR state
+
+// ------ Drawing into the back screen ----
+static void back_fill(int row, int from, int to) {   // { row - screen row, from/to - column range [from, to) }
+    // Erases cells like the terminal does: spaces in the current background color
+    uint32_t blank = CELL_BLANK | (back_attr & CELL_BG_MASK);
+
+    if (row < 0 || row >= UI_SCREEN_ROWS) return;
+    if (from < 0) from = 0;
+    if (to > UI_SCREEN_COLS) to = UI_SCREEN_COLS;
+    for (int c = from; c < to; c++) screen_back[row][c] = blank;
+}
+
+static void back_sgr(const int* p, int np) {   // { p - SGR parameters, np - count (0 means reset) }
+    // Applies "ESC [ p ; p ... m" to the current attribute
+    if (np == 0) back_attr = 0;
+
+    for (int i = 0; i < np; i++) {
+        int v = p[i];
+
+        if (v == 0)                                     back_attr = 0;
+        else if (v == 1)                                back_attr |= CELL_BRIGHT;
+        else if (v == 2)                                back_attr |= CELL_DIM;
+        else if (v == 22)                               back_attr &= ~(CELL_BRIGHT | CELL_DIM);
+        else if (v == 39)                               back_attr &= ~(0xFFu << 8);
+        else if (v == 49)                               back_attr &= ~(0xFFu << 16);
+        else if ((v >= 30 && v <= 37) || (v >= 90 && v <= 97))   back_attr = (back_attr & ~(0xFFu << 8)) | ((uint32_t)v << 8);
+        else if ((v >= 40 && v <= 47) || (v >= 100 && v <= 107)) back_attr = (back_attr & ~(0xFFu << 16)) | ((uint32_t)v << 16);
+    }
+}
+
+static void back_feed(const char* s, size_t n) {   // { s - text with escape sequences, n - length }
+    // Replays terminal output into the back screen
+    for (size_t i = 0; i < n; i++) {
+        unsigned char ch = (unsigned char)s[i];
+
+        if (ch == 0x1b && i + 1 < n && s[i + 1] == '[') {
+            size_t start = i;
+            int p[8] = { 0 };
+            int np = 0;
+            int priv = 0;
+
+            i += 2;
+            if (i < n && s[i] == '?') { priv = 1; i++; }
+
+            for (; i < n && ((s[i] >= '0' && s[i] <= '9') || s[i] == ';'); i++) {
+                if (np == 0) np = 1;
+                if (s[i] == ';') { if (np < 8) np++; }
+                else             p[np - 1] = p[np - 1] * 10 + (s[i] - '0');
+            }
+            if (i >= n) break;
+
+            if (priv) {
+                /* Modes (cursor visibility) do not touch cells: send them through */
+                frame_put(s + start, i - start + 1);
+                continue;
+            }
+
+            switch (s[i]) {
+            case 'H':
+                back_row = ((np >= 1 && p[0] > 0) ? (p[0]) : (1)) - 1;
+                back_col = ((np >= 2 && p[1] > 0) ? (p[1]) : (1)) - 1;
+                break;
+            case 'C':
+                back_col += (np && p[0] > 0) ? (p[0]) : (1);
+                break;
+            case 'J':
+                if (p[0] == 2) {
+                    for (int r = 0; r < UI_SCREEN_ROWS; r++) back_fill(r, 0, UI_SCREEN_COLS);
+                    back_cleared = 1;
+                }
+                break;
+            case 'K':
+                if (p[0] == 2)      back_fill(back_row, 0, UI_SCREEN_COLS);
+                else if (p[0] == 1) back_fill(back_row, 0, back_col + 1);
+                else                back_fill(back_row, back_col, UI_SCREEN_COLS);
+                break;
+            case 'm':
+                back_sgr(p, np);
+                break;
+            default:
+                break;
+            }
+            continue;
+        }
+
+        if (ch == '\n')      { back_row++; back_col = 0; }
+        else if (ch == '\r') back_col = 0;
+        else if (ch == '\t') back_col = (back_col / 8 + 1) * 8;
+        else if (ch >= ' ') {
+            if (back_row < UI_SCREEN_ROWS && back_col < UI_SCREEN_COLS) {
+                screen_back[back_row][back_col] = ch | ((ch == ' ') ? (back_attr & CELL_BG_MASK) : (back_attr));
+            }
+            back_col++;
+        }
+    }
+}
+
+// ------ Sending the difference ----
+static int term_attr_fits(uint32_t cell) {   // { cell - cell about to be printed }
+    // 1 if the terminal colors already show this cell correctly
+    if (term_attr == ATTR_UNKNOWN) return 0;
+    if (CELL_CH(cell) == ' ') return CELL_BG(term_attr) == CELL_BG(cell);
+    return term_attr == CELL_ATTR(cell);
+}
+
+static void term_set_attr(uint32_t attr) {   // { attr - attribute bits of the next cell }
+    // Switches the terminal colors, sending only the SGR parameters that change
+    uint32_t from = term_attr;
+    int reset;
+    char sep = '[';
+
+    if (attr == term_attr) return;
+
+    /* Dropping bright/dim or going back to a default color needs a reset first */
+    reset = (from == ATTR_UNKNOWN)
+        || (from & ~attr & (CELL_BRIGHT | CELL_DIM))
+        || (CELL_FG(from) && !CELL_FG(attr))
+        || (CELL_BG(from) && !CELL_BG(attr));
+    if (reset) {
+        frame_put("\x1b[0", 3);
+        sep = ';';
+        from = 0;
+    }
+    else {
+        frame_putc('\x1b');
+    }
+
+    if ((attr & CELL_BRIGHT) && !(from & CELL_BRIGHT)) { frame_putc(sep); frame_putc('1'); sep = ';'; }
+    if ((attr & CELL_DIM) && !(from & CELL_DIM))       { frame_putc(sep); frame_putc('2'); sep = ';'; }
+    if (CELL_FG(attr) != CELL_FG(from))                { frame_putf("%c%u", sep, CELL_FG(attr)); sep = ';'; }
+    if (CELL_BG(attr) != CELL_BG(from))                { frame_putf("%c%u", sep, CELL_BG(attr)); sep = ';'; }
+    frame_putc('m');
+    term_attr = attr;
+}
+
+static int rel_step(char* out, int n, char up, char down) {   // { out - buffer, n - signed distance, up/down - CSI final for -/+ }
+    // Writes one relative cursor step ("ESC [ n B"); the count is left out for 1
+    if (n == 0) return 0;
+    if (n == 1 || n == -1) return sprintf(out, "\x1b[%c", (n > 0) ? (down) : (up));
+    return sprintf(out, "\x1b[%d%c", (n > 0) ? (n) : (-n), (n > 0) ? (down) : (up));
+}
+
+static void term_move(int row, int col) {   // { row, col - 0-based target }
+    // Moves the real cursor with the cheapest sequence
+    char abs_seq[24], rel_seq[24];
+    int abs_len, rel_len = 1 << 20;
+
+    if (row == term_row && col == term_col) return;
+
+    if (row == term_row && col > term_col && col - term_col <= 4) {
+        int same = 1;
+
+        /* Short hops: reprint the unchanged cells in between when they share the current colors */
+        for (int c = term_col; same && c < col; c++) same = term_attr_fits(screen_front[row][c]);
+
+        if (same) {
+            for (int c = term_col; c < col; c++) frame_putc(CELL_CH(screen_front[row][c]));
+            term_col = col;
+            return;
+        }
+    }
+
+    abs_len = (row == 0 && col == 0) ? sprintf(abs_seq, "\x1b[H") : sprintf(abs_seq, "\x1b[%d;%dH", row + 1, col + 1);
+
+    if (term_row >= 0) {
+        rel_len = rel_step(rel_seq, row - term_row, 'A', 'B');
+        if (col == 0 && term_col != 0) rel_seq[rel_len++] = '\r';
+        else                           rel_len += rel_step(rel_seq + rel_len, col - term_col, 'D', 'C');
+    }
+
+    if (rel_len < abs_len) frame_put(rel_seq, (size_t)rel_len);
+    else                   frame_put(abs_seq, (size_t)abs_len);
+
+    term_row = row;
+    term_col = col;
+}
+
+static int row_blank_from(int r) {   // { r - screen row }
+    // First column from which the back row holds only default blanks
+    int c = UI_SCREEN_COLS;
+    while (c > 0 && screen_back[r][c - 1] == CELL_BLANK) c--;
+    return c;
+}
+
+static void screen_sync(void) {
+    // Sends the cells of screen_back that differ from screen_front
+    if (back_cleared) {
+        int changed = 0, drawn = 0;
+
+        for (int r = 0; r < UI_SCREEN_ROWS; r++) {
+            for (int c = 0; c < UI_SCREEN_COLS; c++) {
+                changed += (screen_back[r][c] != screen_front[r][c]);
+                drawn += (screen_back[r][c] != CELL_BLANK);
+            }
+        }
+
+        /* A real clear is cheaper when most of the old screen has to go */
+        if (!front_valid || drawn < changed) {
+            term_set_attr(0);
+            frame_put("\x1b[2J", 4);
+            for (int r = 0; r < UI_SCREEN_ROWS; r++) {
+                for (int c = 0; c < UI_SCREEN_COLS; c++) screen_front[r][c] = CELL_BLANK;
+            }
+            front_valid = 1;
+        }
+        back_cleared = 0;
+    }
+
+    for (int r = 0; r < UI_SCREEN_ROWS; r++) {
+        int tail = row_blank_from(r);
+        int erase = -1;
+
+        /* Old text right of the new line end goes with one "erase to end of line" */
+        for (int c = tail; c < UI_SCREEN_COLS; c++) {
+            if (screen_front[r][c] != CELL_BLANK) { erase = c; break; }
+        }
+
+        for (int c = 0; c < tail; c++) {
+            uint32_t cell = screen_back[r][c];
+            if (cell == screen_front[r][c]) continue;
+
+            term_move(r, c);
+            if (!term_attr_fits(cell)) term_set_attr(CELL_ATTR(cell));
+            frame_putc(CELL_CH(cell));
+            screen_front[r][c] = cell;
+            frame_stats.cells++;
+
+            /* The last column leaves the cursor in a pending-wrap state */
+            term_col = (c + 1 < UI_SCREEN_COLS) ? (c + 1) : (-1);
+            if (term_col < 0) term_row = -1;
+        }
+
+        if (erase >= 0) {
+            term_move(r, erase);
+            term_set_attr(0);
+            frame_put("\x1b[K", 3);
+            for (int c = erase; c < UI_SCREEN_COLS; c++) screen_front[r][c] = CELL_BLANK;
+        }
+    }
+}
+
+/*=======*/
+
+
+// ===== Frame composition ======
+
+void ui_printf(const char* fmt, ...) {   // { fmt - printf format }
+    // Draws formatted text (with escape sequences) into the current frame
+    static char text[UI_FRAME_BYTES];
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = vsnprintf(text, sizeof(text), fmt, ap);
+    va_end(ap);
+    if (n < 0) return;
+    if ((size_t)n >= sizeof(text)) n = (int)sizeof(text) - 1;
+
+    if (screen_diff) back_feed(text, (size_t)n);
+    else             frame_put(text, (size_t)n);
+}
+
+void ui_flush(void) {
+    // Emits the composed frame with one write and closes its counters
+    if (screen_diff) screen_sync();
+    if (!frame_len) {
+        input_mark = 0;   /* The key changed nothing on screen */
+        return;
+    }
+
+    frame_emit();
+
+    if (input_mark > 0) {
+        double ms = time_now_ms() - input_mark;
+
+        frame_stats.input_frames++;
+        frame_stats.input_ms_total += ms;
+        if (ms > frame_stats.input_ms_max) frame_stats.input_ms_max = ms;
+        input_mark = 0;
+    }
+
+    frame_stats.frames++;
+    frame_stats.bytes += frame_bytes;
+    frame_stats.writes += frame_writes;
+    frame_stats.last_bytes = frame_bytes;
+    frame_stats.last_writes = frame_writes;
+    frame_bytes = 0;
+    frame_writes = 0;
+}
+
+void ui_set_diff(int on) {   // { on - 1 send only changed cells, 0 send every drawn byte }
+    // Selects the renderer; call before drawing anything
+    screen_diff = on;
+}
+
+void ui_frame_stats(ui_frame_stats_t* out) {   // { out - counters since startup }
+    // Copies the frame counters
+    *out = frame_stats;
+}
+
+// ------ Input ----
+int ui_getch(void) {
+    // Shows the pending frame, then waits for a key
+    ui_flush();
+    return read_key();
+}
+
+void ui_mark_input(double t_ms) {   // { t_ms - time_now_ms() when the key arrived }
+    // Remembers a consumed key; the next frame sent measures keypress-to-frame latency
+    if (input_mark <= 0) input_mark = t_ms;
 }
 
 /*=======*/
@@ -36,20 +480,19 @@ void delay_ms(int ms) {   // { ms - delay time in milliseconds }
 // ------ Screen clearing ----
 void clear_screen(void) {
     // Clears the entire console screen and resets cursor position
-    printf(ANSI_CLEAR_SCREEN ANSI_CURSOR_HOME);
-    fflush(stdout);
+    ui_printf(ANSI_CLEAR_SCREEN ANSI_CURSOR_HOME);
 }
 
 // ------ Cursor movements ----
 void cursor_goto(int row, int col) {   // { row - needed row, col - needed column }
     // Moves the cursor to board [row, col]
-    printf("\x1b[%d;%dH", row, col);
+    ui_printf("\x1b[%d;%dH", row, col);
 }
 
 // ------ Line clearing ----
 void clear_line(void) {
     // Clears the current console line
-    printf("\x1b[2K");
+    ui_printf("\x1b[2K");
 }
 
 /*=======*/
@@ -63,20 +506,18 @@ void ui_menu_init(void) {
 
     clear_screen();
 
-    printf("+----------------------------------------------------+\n");
-    printf(ANSI_FG_RED ANSI_BRIGHT);
-    printf(LOGO_4_IN_A_ROW);
-    printf(ANSI_RESET "\n");
+    ui_printf("+----------------------------------------------------+\n");
+    ui_printf(ANSI_FG_RED ANSI_BRIGHT);
+    ui_printf(LOGO_4_IN_A_ROW);
+    ui_printf(ANSI_RESET "\n");
 
-    printf(ANSI_FG_YELLOW ANSI_BRIGHT "UP/DOWN move | ENTER/SPACE select | ESC quit\n\n"  ANSI_FG_WHITE);
+    ui_printf(ANSI_FG_YELLOW ANSI_BRIGHT "UP/DOWN move | ENTER/SPACE select | ESC quit\n\n"  ANSI_FG_WHITE);
 
     // Reserve vertical space for menu options
-    printf("\n\n\n\n\n\n");
-
-    printf("+----------------------------------------------------+\n");
-    printf(ANSI_RESET);
+    for (int i = 0; i < MENU_OPTIONS; i++) ui_printf("\n");
 
-    fflush(stdout);
+    ui_printf("+----------------------------------------------------+\n");
+    ui_printf(ANSI_RESET);
 }
 
 // ------ Menu options rendering ----
@@ -88,14 +529,12 @@ void ui_menu_draw_options(int selected) {   // { selected - currently selected o
         clear_line();
 
         if (i == selected) {
-            printf(ANSI_BG_RED ANSI_FG_WHITE ANSI_BRIGHT "  > %s  " ANSI_RESET, options[i]);
+            ui_printf(ANSI_BG_RED ANSI_FG_WHITE ANSI_BRIGHT "  > %s  " ANSI_RESET, options[i]);
         }
         else {
-            printf(ANSI_FG_GRAY "    %s" ANSI_RESET, options[i]);
+            ui_printf(ANSI_FG_GRAY "    %s" ANSI_RESET, options[i]);
         }
     }
-
-    fflush(stdout);
 }
 
 // ------ Menu selection flash ----
@@ -103,6 +542,9 @@ void ui_menu_flash_selected(int selected) {   // { selected - option to flash }
     // Blinks the selected menu option by alternating background colors
 
     char* color;
+    ui_timer_t timer;
+
+    ui_timer_start(&timer, 110);
 
     for (int t = 0; t < 6; t++) {
         color = (t % 2 == 1) ? (ANSI_BG_RED) : (ANSI_BG_BLUE);
@@ -110,11 +552,10 @@ void ui_menu_flash_selected(int selected) {   // { selected - option to flash }
         cursor_goto(MENU_TOP_ROW + selected, MENU_LEFT_COL);
         clear_line();
 
-        printf("%s" ANSI_FG_WHITE ANSI_BRIGHT "  > %s  " ANSI_RESET,
+        ui_printf("%s" ANSI_FG_WHITE ANSI_BRIGHT "  > %s  " ANSI_RESET,
             color, options[selected]);
 
-        fflush(stdout);
-        delay_ms(110);
+        if (ui_timer_wait(&timer)) break;   /* A key press ends the flash early */
     }
 }
 
@@ -127,32 +568,37 @@ void ui_menu_flash_selected(int selected) {   // { selected - option to flash }
 void ui_display_manual(void) {
     // Displays the game manual and waits for user input
 
-    printf(ANSI_FG_CYAN ANSI_BRIGHT "HOW TO PLAY\n" ANSI_FG_GRAY);
-    printf("----------------------------------------\n");
+    ui_printf(ANSI_FG_CYAN ANSI_BRIGHT "HOW TO PLAY\n" ANSI_FG_GRAY);
+    ui_printf("----------------------------------------\n");
 
-    printf(ANSI_FG_YELLOW ANSI_BRIGHT "Controls:\n\n");
+    ui_printf(ANSI_FG_YELLOW ANSI_BRIGHT "Controls:\n\n");
 
-    printf(ANSI_FG_WHITE "UP / DOWN / LEFT / RIGHT"
+    ui_printf(ANSI_FG_WHITE "UP / DOWN / LEFT / RIGHT"
         ANSI_FG_GRAY "  - Move selector / column\n");
 
-    printf(ANSI_FG_WHITE "ENTER or SPACE "
+    ui_printf(ANSI_FG_WHITE "ENTER or SPACE "
         ANSI_FG_GRAY "           - Drop a chip\n");
 
-    printf(ANSI_FG_WHITE "R / r"
+    ui_printf(ANSI_FG_WHITE "R / r"
         ANSI_FG_GRAY "                     - Reset the game\n");
 
-    printf(ANSI_FG_WHITE "ESC"
+    ui_printf(ANSI_FG_WHITE "U / Y"
+        ANSI_FG_GRAY "                     - Undo / redo a move (vs AI: your move and the reply)\n");
+
+    ui_printf(ANSI_FG_WHITE "ESC"
         ANSI_FG_GRAY "                       - Return to menu\n\n");
 
-    printf(ANSI_FG_GREEN ANSI_BRIGHT "Goal: "
+    ui_printf(ANSI_FG_GREEN ANSI_BRIGHT "Goal: "
         ANSI_FG_WHITE "Connect "
         ANSI_FG_RED "4"
         ANSI_FG_WHITE " chips in a row (horizontal, vertical, or diagonal)\n\n");
 
-    printf(ANSI_FG_GRAY "Press any key to return...");
-    fflush(stdout);
+    ui_printf(ANSI_FG_GRAY "Board sizes (start with --board <cols>x<rows>):");
+    for (int i = 0; i < geo_kernel_count(); i++) ui_printf(" %s", geo_kernel_at(i)->name);
+    ui_printf("\n\n");
 
-    _getch();
+    ui_printf(ANSI_FG_GRAY "Press any key to return...");
+    ui_getch();
 }
 
 /*=======*/
@@ -0,0 +1,238 @@
+#include <time.h>
+#include "Game_ai.h"
+#include "Game_time.h"
+
+
+// ===== Move choosers ======
+
+// ------ AI random (EZ mode) ----
+int ai_choose_column(const board_t* board, rng_t* rng) {   // { board - game board, rng - caller's generator }
+    // Picks uniformly among the non-full columns with at most two draws (no retry loop on a nearly full board)
+    int col = rng_below(rng, COLS);
+    return (board_can_play(board, col)) ? (col) : (rng_pick(rng, board_column_mask(board)));
+}
+
+// ------ AI center heuristic ----
+int ai_choose_column_center(const board_t* board, int ai_player) {   // { board - game board, ai_player - AI player id (1/2) }
+    // Win if possible, block human win, otherwise prefer center columns
+
+    int human = (ai_player == 1) ? 2 : 1;
+
+    /* 1) WIN NOW / 2) BLOCK HUMAN WIN (threat masks, lowest column first) */
+    if (board_winning_moves(board, ai_player)) return board_move_column(board_winning_moves(board, ai_player));
+    if (board_winning_moves(board, human))     return board_move_column(board_winning_moves(board, human));
+
+    /* 3) FALLBACK: center-ish preference, otherwise random valid */
+    {
+        int pref[COLS] = { 3, 2, 4, 1, 5, 0, 6 };
+        for (int i = 0; i < COLS; i++) {
+            int c = pref[i];
+            if (board_can_play(board, c)) return c;
+        }
+    }
+
+    return 0;
+}
+
+// ------ AI hard mode ----
+int ai_choose_column_hard(const board_t* board, int ai_player, const egdb_t* db) {   // { board - game board, ai_player - AI player id (1/2), db - endgame database (can be NULL) }
+    // Hard AI: win if possible, perfect play inside the endgame database, block human win,
+    // otherwise an AI_HARD_DEPTH look-ahead scored by Game_eval
+    int human = (ai_player == 1) ? 2 : 1;
+    bitboard_t wins = board_winning_moves(board, ai_player);
+    bitboard_t safe;
+
+    /* 1) WIN NOW */
+    if (wins) return board_move_column(wins);
+
+    /* 1b) IN DATABASE RANGE: one probe per reply instead of a search */
+    if (db) {
+        int col = egdb_best_move(db, board, NULL);
+        if (col >= 0) return col;
+    }
+
+    /* 2) BLOCK HUMAN WIN / 3) NEVER PLAY UNDER A HUMAN THREAT: a single safe move needs no look-ahead */
+    safe = board_safe_moves(board);
+    if (safe && !(safe & (safe - 1))) return board_move_column(safe);
+    if (!safe && board_winning_moves(board, human)) return board_move_column(board_winning_moves(board, human));
+
+    /* 4) Threats, parity and center control, AI_HARD_DEPTH plies deep (losing moves are pruned there too) */
+    {
+        int col = eval_best_move(board, AI_HARD_DEPTH, NULL, NULL);
+        return (col >= 0) ? (col) : (ai_choose_column_center(board, ai_player));
+    }
+}
+
+// ------ AI expert mode ----
+int ai_choose_column_expert(const board_t* board, const search_params_t* params, tt_t* tt,
+                            const book_t* book, pns_t* pns, search_result_t* res) {   // { params - search limits, tt/book/pns - can be NULL, res - search stats }
+    // Expert AI: proven book entries first, then a df-pn attempt to prove a forced win within AI_PNS_NODES
+    // and a 1/AI_PNS_SHARE slice of the move time, else iterative deepening negamax on the rest.
+    // A book estimate is only the first move the search tries: a live search sees deeper.
+    search_params_t rest;
+    pns_result_t proof = { PNS_UNKNOWN, -1, 0, 0, 0, 0.0 };
+    int proof_ms = 0;   /* No time limit: nodes only */
+    int hint = 0;
+    int col, score, exact;
+
+    if (book_probe(book, board, &col, &score, &exact)) {
+        if (exact) {
+            search_result_t book_res = { col, score, 0, 0, 1, 0, 0, 0, 0.0, 0, 0 };
+            *res = book_res;
+            return col;
+        }
+        hint = col + 1;
+    }
+
+    if (params->time_ms > 0) {
+        proof_ms = params->time_ms / AI_PNS_SHARE;
+        if (proof_ms < 1) proof_ms = 1;   /* 0 would mean no limit */
+    }
+
+    if (pns && pns_prove(pns, board, AI_PNS_NODES, proof_ms, &proof) == PNS_PROVEN && proof.best_col >= 0) {
+        /* The proof says the move wins, not how fast: report the slowest forced win */
+        search_result_t pns_res = { proof.best_col, SEARCH_WIN_MIN + 1, 0, 1, 0, proof.nodes, 0, 0, proof.ms, 0, 1 };
+        *res = pns_res;
+        return proof.best_col;
+    }
+
+    rest = *params;
+    if (!rest.root_hint) rest.root_hint = hint;
+    if (rest.time_ms > 0) rest.time_ms = (rest.time_ms > (int)proof.ms + 1) ? (rest.time_ms - (int)proof.ms) : (1);
+
+    col = search_best_move(board, &rest, tt, res);
+    res->nodes += proof.nodes;   /* Stats cover the failed proof too */
+    res->ms += proof.ms;
+    return col;
+}
+
+// ------ AI MCTS mode ----
+int ai_choose_column_mcts(const board_t* board, mcts_t* tree, const mcts_params_t* params,
+                          mcts_result_t* res) {   // { tree - node arena, params - limits, res - search stats }
+    // MCTS AI: random playouts steer a UCT tree grown in the caller's arena
+    return mcts_best_move(tree, board, params, res);
+}
+
+/*=======*/
+
+
+// ===== Pondering ======
+
+// ------ Background thread ----
+static int ponder_main(void* arg) {   // { arg - ai_ponder_t }
+    // Searches p->root without a time limit until stopped or the result is proven
+    ai_ponder_t* p = (ai_ponder_t*)arg;
+
+    p->col = search_best_move(&p->root, &p->params, p->tt, &p->res);
+
+    mtx_lock(&p->lock);
+    atomic_store(&p->done, 1);
+    cnd_signal(&p->cond);
+    mtx_unlock(&p->lock);
+    return 0;
+}
+
+void ai_ponder_init(ai_ponder_t* p) {   // { p - ponder state }
+    // Prepares an idle ponder state (call once)
+    p->running = 0;
+    atomic_init(&p->stop, 0);
+    atomic_init(&p->done, 0);
+    mtx_init(&p->lock, mtx_plain);
+    cnd_init(&p->cond);
+}
+
+// ------ Start ----
+void ai_ponder_start(ai_ponder_t* p, const board_t* board, const search_params_t* params,
+                     tt_t* tt, const book_t* book) {   // { board - position after the AI move, params - search limits, tt - shared table, book - can be NULL }
+    // Guesses the human reply from the table and searches the position after it in the background
+    tt_data_t e;
+    int player = board_player_to_move(board);
+    int mirrored;
+
+    ai_ponder_stop(p);
+    if (!tt || board_is_full(board)) return;
+    if (book && board->moves < book_max_ply(book)) return;   /* The book answers the next move anyway */
+
+    p->root = *board;
+    p->predicted = -1;
+
+    /* Mirror images share one table entry; its move is stored for the canonical orientation */
+    if (tt_probe(tt, board_canonical_key(board, &mirrored), &e) && e.move < COLS
+        && board_can_play(board, board_mirror_col(e.move, mirrored))) {
+        int col = board_mirror_col(e.move, mirrored);
+        board_t next = *board;
+        board_drop(&next, col, player);
+
+        /* A winning or drawing reply ends the game: nothing to ponder after it */
+        if (!board_has_won(&next, player) && !board_is_full(&next)) {
+            p->root = next;
+            p->predicted = col;
+        }
+    }
+
+    p->params = *params;
+    p->params.time_ms = 0;
+    p->params.max_depth = SEARCH_MAX_DEPTH;
+    p->params.stop = &p->stop;
+    p->tt = tt;
+    p->col = -1;
+    p->start = time_now_ms();
+    atomic_store(&p->stop, 0);
+    atomic_store(&p->done, 0);
+
+    if (thrd_create(&p->thread, ponder_main, p) == thrd_success) p->running = 1;
+}
+
+// ------ Human moved ----
+int ai_ponder_finish(ai_ponder_t* p, const board_t* board, int time_ms, search_result_t* res) {   // { board - position after the human move, time_ms - AI budget, res - out }
+    // On a correct guess keeps searching until the AI's budget (ponder time included) is spent,
+    // then returns the ponder result. Otherwise stops the ponder and returns -1; the table stays warm.
+    double asked = time_now_ms();
+    double deadline;
+
+    if (!p->running) return -1;
+
+    if (p->predicted < 0 || board_key(board) != board_key(&p->root)) {
+        ai_ponder_stop(p);
+        return -1;
+    }
+
+    /* Ponder hit: the search already ran on this very position */
+    deadline = p->start + time_ms;
+
+    mtx_lock(&p->lock);
+    while (!atomic_load(&p->done)) {
+        double left = deadline - time_now_ms();
+        struct timespec ts;
+        long long ns;
+
+        if (left <= 0) break;
+
+        timespec_get(&ts, TIME_UTC);
+        ns = (long long)ts.tv_nsec + (long long)(left * 1000000.0);
+        ts.tv_sec += (time_t)(ns / 1000000000LL);
+        ts.tv_nsec = (long)(ns % 1000000000LL);
+        cnd_timedwait(&p->cond, &p->lock, &ts);
+    }
+    mtx_unlock(&p->lock);
+
+    ai_ponder_stop(p);
+    if (p->col < 0) return -1;
+
+    *res = p->res;
+    res->ms = time_now_ms() - asked;   /* What the human waited, not the whole ponder */
+    res->pondered = 1;
+    return p->col;
+}
+
+// ------ Stop ----
+void ai_ponder_stop(ai_ponder_t* p) {   // { p - ponder state }
+    // Raises the stop flag and joins the thread
+    if (!p->running) return;
+
+    atomic_store(&p->stop, 1);
+    thrd_join(p->thread, NULL);
+    p->running = 0;
+}
+
+/*=======*/
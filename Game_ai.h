@@ -0,0 +1,81 @@
+#ifndef GAME_AI_H
+#define GAME_AI_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <threads.h>
+#include "Game_board.h"
+#include "Game_book.h"
+#include "Game_egdb.h"
+#include "Game_eval.h"
+#include "Game_mcts.h"
+#include "Game_pns.h"
+#include "Game_rng.h"
+#include "Game_search.h"
+#include "Game_tt.h"
+
+
+// ===== AI constants ======
+
+#define AI_HARD_DEPTH   6           // Plies the HARD AI looks ahead with the static evaluation
+#define AI_PNS_NODES    100000      // df-pn expansions the EXPERT AI tries before searching (about 60 ms)
+#define AI_PNS_SHARE    4           // ... and at most 1/AI_PNS_SHARE of its move time
+
+/*=======*/
+
+
+// ===== AI types ======
+
+// ------ Pondering ----
+// After the AI moves, a background search keeps working while the human
+// thinks: on the position after the reply the table predicts, or on the
+// human's own position (all seven replies) when there is no prediction.
+// A correct guess lets the running search simply continue.
+typedef struct {
+    thrd_t thread;
+    int running;            // 1 - thread started and not joined yet
+    atomic_int stop;        // Ends the ponder search
+    atomic_int done;        // Set by the thread when its search returned
+    mtx_t lock;             // Guards the done signal
+    cnd_t cond;
+    board_t root;           // Position searched
+    int predicted;          // Human column the search assumes (-1 - pondering the human's position)
+    search_params_t params;
+    tt_t* tt;
+    search_result_t res;    // Filled when the thread ends
+    int col;
+    double start;           // time_now_ms() when pondering began
+} ai_ponder_t;
+
+/*=======*/
+
+
+// ===== AI functions ======
+//
+// Headless move choosers shared by the interactive game (Game_PvP.c) and
+// the self-play harness (Game_selfplay.c). None of them touch global state,
+// so any number of games can run on different threads.
+
+// ------ Move choosers ----
+int ai_choose_column(const board_t* board, rng_t* rng);             // EZ: uniform non-full column (-1 if full)
+int ai_choose_column_center(const board_t* board, int ai_player);   // Win now, block, else center (the former HARD)
+int ai_choose_column_hard(const board_t* board, int ai_player,
+                          const egdb_t* db);                       // HARD: win now, endgame database, block, else look-ahead (db can be NULL)
+int ai_choose_column_expert(const board_t* board, const search_params_t* params, tt_t* tt,
+                            const book_t* book, pns_t* pns,
+                            search_result_t* res);                 // EXPERT: book, forced-win proof, else search (book/tt/pns can be NULL)
+int ai_choose_column_mcts(const board_t* board, mcts_t* tree, const mcts_params_t* params,
+                          mcts_result_t* res);                     // MCTS: most visited move of a parallel UCT search
+
+// ------ Pondering (EXPERT) ----
+void ai_ponder_init(ai_ponder_t* p);                                   // Idle ponder state
+void ai_ponder_start(ai_ponder_t* p, const board_t* board, const search_params_t* params,
+                     tt_t* tt, const book_t* book);                    // { board - human to move } Starts the background search
+int  ai_ponder_finish(ai_ponder_t* p, const board_t* board, int time_ms,
+                      search_result_t* res);                           // { board - after the human move } Column if the guess was right, else -1
+void ai_ponder_stop(ai_ponder_t* p);                                   // Ends and joins the background search (idle is fine)
+
+/*=======*/
+
+
+#endif /* GAME_AI_H */
@@ -0,0 +1,272 @@
+#include <stdatomic.h>
+#include "Game_batch.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define BATCH_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(BATCH_HAVE_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+#define BATCH_HAVE_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define BATCH_TARGET_AVX2
+#else
+#define BATCH_TARGET_AVX2   __attribute__((target("avx2")))   // Only these functions use AVX2; the CPU is checked first
+#endif
+#endif
+
+
+// ===== Board constants ======
+//
+// The masks and the scalar win test come from Game_board.h (BOARD_BOTTOM,
+// BOARD_MASK, bitboard_winning_cells); only the SIMD shifts live here.
+
+#define H1  BOARD_H1
+
+/*=======*/
+
+
+// ===== Scalar kernel ======
+//
+// The reference for the SIMD kernels, which follow it step by step:
+//   legal    = (occupied + bottom) & full      one new cell per open column
+//   wins     = legal & cells completing four   bitboard_winning_cells()
+//   terminal = opp has four | occupied == full
+
+static void eval_scalar(const batch_t* b, size_t from, size_t n) {   // { from - first slot, n - end slot }
+    const uint64_t bottom = BOARD_BOTTOM;
+    const uint64_t full = BOARD_MASK;
+
+    for (size_t i = from; i < n; i++) {
+        uint64_t own = b->own[i];
+        uint64_t occ = own | b->opp[i];
+        int term = bitboard_has_four(b->opp[i]) || occ == full;
+        uint64_t legal = (term) ? 0 : ((occ + bottom) & full);
+
+        b->legal[i] = legal;
+        b->wins[i] = bitboard_winning_cells(own, occ) & legal;
+        b->terminal[i] = (uint8_t)term;
+    }
+}
+
+/*=======*/
+
+
+// ===== SSE2 kernel (2 positions per register) ======
+
+#ifdef BATCH_HAVE_SSE2
+
+static inline __m128i sse_eq_zero(__m128i x) {
+    // All-ones in every 64-bit lane that is zero (SSE2 only compares 32-bit lanes)
+    __m128i e = _mm_cmpeq_epi32(x, _mm_setzero_si128());
+    return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+static inline __m128i sse_four(__m128i x) {
+    // Nonzero lanes where x has four in a row (same shifts as bitboard_has_four)
+    __m128i m, acc;
+
+    m = _mm_and_si128(x, _mm_srli_epi64(x, H1));
+    acc = _mm_and_si128(m, _mm_srli_epi64(m, 2 * H1));
+    m = _mm_and_si128(x, _mm_srli_epi64(x, H1 - 1));
+    acc = _mm_or_si128(acc, _mm_and_si128(m, _mm_srli_epi64(m, 2 * (H1 - 1))));
+    m = _mm_and_si128(x, _mm_srli_epi64(x, H1 + 1));
+    acc = _mm_or_si128(acc, _mm_and_si128(m, _mm_srli_epi64(m, 2 * (H1 + 1))));
+    m = _mm_and_si128(x, _mm_srli_epi64(x, 1));
+    acc = _mm_or_si128(acc, _mm_and_si128(m, _mm_srli_epi64(m, 2)));
+    return acc;
+}
+
+static inline __m128i sse_winning(__m128i p) {
+    // SIMD bitboard_winning_cells() (before the empty-cell mask; callers AND with legal)
+    __m128i r = _mm_and_si128(_mm_and_si128(_mm_slli_epi64(p, 1), _mm_slli_epi64(p, 2)), _mm_slli_epi64(p, 3));
+    __m128i t;
+
+#define WIN_DIR(d) \
+    t = _mm_and_si128(_mm_slli_epi64(p, (d)), _mm_slli_epi64(p, 2 * (d))); \
+    r = _mm_or_si128(r, _mm_and_si128(t, _mm_slli_epi64(p, 3 * (d)))); \
+    r = _mm_or_si128(r, _mm_and_si128(t, _mm_srli_epi64(p, (d)))); \
+    t = _mm_and_si128(_mm_srli_epi64(p, (d)), _mm_srli_epi64(p, 2 * (d))); \
+    r = _mm_or_si128(r, _mm_and_si128(t, _mm_slli_epi64(p, (d)))); \
+    r = _mm_or_si128(r, _mm_and_si128(t, _mm_srli_epi64(p, 3 * (d))));
+
+    WIN_DIR(H1)
+    WIN_DIR(H1 - 1)
+    WIN_DIR(H1 + 1)
+#undef WIN_DIR
+
+    return r;
+}
+
+static void eval_sse2(const batch_t* b, size_t n) {
+    const __m128i bottom = _mm_set1_epi64x((long long)BOARD_BOTTOM);
+    const __m128i full = _mm_set1_epi64x((long long)BOARD_MASK);
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        __m128i own = _mm_loadu_si128((const __m128i*)(b->own + i));
+        __m128i opp = _mm_loadu_si128((const __m128i*)(b->opp + i));
+        __m128i occ = _mm_or_si128(own, opp);
+
+        /* terminal = four for opp (nonzero) or a full board (occ ^ full == 0) */
+        __m128i open = _mm_andnot_si128(sse_eq_zero(_mm_xor_si128(occ, full)), sse_eq_zero(sse_four(opp)));
+        __m128i legal = _mm_and_si128(_mm_and_si128(_mm_add_epi64(occ, bottom), full), open);
+        int term = ~_mm_movemask_pd(_mm_castsi128_pd(open)) & 3;
+
+        _mm_storeu_si128((__m128i*)(b->legal + i), legal);
+        _mm_storeu_si128((__m128i*)(b->wins + i), _mm_and_si128(sse_winning(own), legal));
+        b->terminal[i] = (uint8_t)(term & 1);
+        b->terminal[i + 1] = (uint8_t)(term >> 1);
+    }
+
+    eval_scalar(b, i, n);
+}
+
+#endif
+
+/*=======*/
+
+
+// ===== AVX2 kernel (4 positions per register) ======
+
+#ifdef BATCH_HAVE_AVX2
+
+BATCH_TARGET_AVX2 static inline __m256i avx_four(__m256i x) {
+    // Nonzero lanes where x has four in a row
+    __m256i m, acc;
+
+    m = _mm256_and_si256(x, _mm256_srli_epi64(x, H1));
+    acc = _mm256_and_si256(m, _mm256_srli_epi64(m, 2 * H1));
+    m = _mm256_and_si256(x, _mm256_srli_epi64(x, H1 - 1));
+    acc = _mm256_or_si256(acc, _mm256_and_si256(m, _mm256_srli_epi64(m, 2 * (H1 - 1))));
+    m = _mm256_and_si256(x, _mm256_srli_epi64(x, H1 + 1));
+    acc = _mm256_or_si256(acc, _mm256_and_si256(m, _mm256_srli_epi64(m, 2 * (H1 + 1))));
+    m = _mm256_and_si256(x, _mm256_srli_epi64(x, 1));
+    acc = _mm256_or_si256(acc, _mm256_and_si256(m, _mm256_srli_epi64(m, 2)));
+    return acc;
+}
+
+BATCH_TARGET_AVX2 static inline __m256i avx_winning(__m256i p) {
+    // SIMD bitboard_winning_cells() (before the empty-cell mask; callers AND with legal)
+    __m256i r = _mm256_and_si256(_mm256_and_si256(_mm256_slli_epi64(p, 1), _mm256_slli_epi64(p, 2)), _mm256_slli_epi64(p, 3));
+    __m256i t;
+
+#define WIN_DIR(d) \
+    t = _mm256_and_si256(_mm256_slli_epi64(p, (d)), _mm256_slli_epi64(p, 2 * (d))); \
+    r = _mm256_or_si256(r, _mm256_and_si256(t, _mm256_slli_epi64(p, 3 * (d)))); \
+    r = _mm256_or_si256(r, _mm256_and_si256(t, _mm256_srli_epi64(p, (d)))); \
+    t = _mm256_and_si256(_mm256_srli_epi64(p, (d)), _mm256_srli_epi64(p, 2 * (d))); \
+    r = _mm256_or_si256(r, _mm256_and_si256(t, _mm256_slli_epi64(p, (d)))); \
+    r = _mm256_or_si256(r, _mm256_and_si256(t, _mm256_srli_epi64(p, 3 * (d))));
+
+    WIN_DIR(H1)
+    WIN_DIR(H1 - 1)
+    WIN_DIR(H1 + 1)
+#undef WIN_DIR
+
+    return r;
+}
+
+BATCH_TARGET_AVX2 static void eval_avx2(const batch_t* b, size_t n) {
+    const __m256i bottom = _mm256_set1_epi64x((long long)BOARD_BOTTOM);
+    const __m256i full = _mm256_set1_epi64x((long long)BOARD_MASK);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i own = _mm256_loadu_si256((const __m256i*)(b->own + i));
+        __m256i opp = _mm256_loadu_si256((const __m256i*)(b->opp + i));
+        __m256i occ = _mm256_or_si256(own, opp);
+
+        __m256i open = _mm256_andnot_si256(_mm256_cmpeq_epi64(occ, full), _mm256_cmpeq_epi64(avx_four(opp), zero));
+        __m256i legal = _mm256_and_si256(_mm256_and_si256(_mm256_add_epi64(occ, bottom), full), open);
+        int term = ~_mm256_movemask_pd(_mm256_castsi256_pd(open)) & 15;
+
+        _mm256_storeu_si256((__m256i*)(b->legal + i), legal);
+        _mm256_storeu_si256((__m256i*)(b->wins + i), _mm256_and_si256(avx_winning(own), legal));
+        for (int k = 0; k < 4; k++) b->terminal[i + k] = (uint8_t)((term >> k) & 1);
+    }
+
+    eval_scalar(b, i, n);
+}
+
+#endif
+
+/*=======*/
+
+
+// ===== Dispatch ======
+
+// ------ CPU detection ----
+static int detect_level(void) {
+    // Returns the best level both the build and the CPU (and OS, for the AVX state) support
+#if defined(BATCH_HAVE_AVX2) && defined(_MSC_VER)
+    int r[4];
+
+    __cpuid(r, 0);
+    if (r[0] >= 7) {
+        __cpuid(r, 1);
+        int osxsave_avx = (r[2] & (1 << 27)) && (r[2] & (1 << 28));
+
+        __cpuidex(r, 7, 0);
+        if (osxsave_avx && (r[1] & (1 << 5)) && (_xgetbv(0) & 6) == 6) return BATCH_AVX2;
+    }
+    return BATCH_SSE2;
+#elif defined(BATCH_HAVE_AVX2)
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports("avx2")) ? BATCH_AVX2 : BATCH_SSE2;
+#elif defined(BATCH_HAVE_SSE2)
+    return BATCH_SSE2;
+#else
+    return BATCH_SCALAR;
+#endif
+}
+
+static atomic_int best_level = -1;   // Cached detect_level() (-1 - not yet detected)
+
+int batch_best_level(void) {
+    int level = atomic_load_explicit(&best_level, memory_order_relaxed);
+
+    if (level < 0) {
+        level = detect_level();
+        atomic_store_explicit(&best_level, level, memory_order_relaxed);
+    }
+    return level;
+}
+
+const char* batch_level_name(int level) {
+    switch (level) {
+    case BATCH_AVX2: return "avx2";
+    case BATCH_SSE2: return "sse2";
+    default:         return "scalar";
+    }
+}
+
+// ------ Entry points ----
+void batch_eval_level(const batch_t* b, size_t n, int level) {   // { b - arrays of n slots, level - BATCH_* }
+    // Fills legal / wins / terminal for n positions with the requested kernel (or the best one below it)
+    int best = batch_best_level();
+    if (level > best) level = best;
+
+#ifdef BATCH_HAVE_AVX2
+    if (level == BATCH_AVX2) {
+        eval_avx2(b, n);
+        return;
+    }
+#endif
+#ifdef BATCH_HAVE_SSE2
+    if (level == BATCH_SSE2) {
+        eval_sse2(b, n);
+        return;
+    }
+#endif
+    eval_scalar(b, 0, n);
+}
+
+void batch_eval(const batch_t* b, size_t n) {
+    batch_eval_level(b, n, batch_best_level());
+}
+
+/*=======*/
@@ -0,0 +1,65 @@
+#ifndef GAME_BATCH_H
+#define GAME_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Game_board.h"
+
+
+// ===== Batched position queries ======
+//
+// Answers the per-node questions of playouts and analysis for many
+// independent positions at once. The input is a struct of arrays of
+// bitboards, so a SIMD register holds the same field of 2 (SSE2) or
+// 4 (AVX2) positions. No kernel has a data-dependent branch.
+//
+// Results are cell bitboards in the Game_board.h layout. batch_columns()
+// turns one into a column mask.
+
+// ------ Kernel levels ----
+#define BATCH_SCALAR    0
+#define BATCH_SSE2      1
+#define BATCH_AVX2      2
+
+typedef struct {
+    const uint64_t* own;    // Chips of the side to move
+    const uint64_t* opp;    // Chips of the other side
+    uint64_t* legal;        // out: landing cell of every playable column (0 once the game is over)
+    uint64_t* wins;         // out: landing cells that make four for the side to move (0 once the game is over)
+    uint8_t* terminal;      // out: 1 - the opponent has four in a row or the board is full
+} batch_t;
+
+/*=======*/
+
+
+// ===== Batch functions ======
+
+// ------ Kernels ----
+void batch_eval(const batch_t* b, size_t n);                        // { n - positions } Fastest kernel this CPU runs
+void batch_eval_level(const batch_t* b, size_t n, int level);       // { level - BATCH_* } Capped at batch_best_level()
+int  batch_best_level(void);                                        // Highest BATCH_* the CPU supports
+const char* batch_level_name(int level);
+
+// ------ Conversions ----
+static inline void batch_set(uint64_t* own, uint64_t* opp, size_t i, const board_t* b) {   // { i - slot, b - position }
+    // Stores b into slot i of the input arrays
+    int side = b->moves & 1;
+
+    own[i] = b->chips[side];
+    opp[i] = b->chips[side ^ 1];
+}
+
+static inline int batch_columns(uint64_t cells) {   // { cells - legal / wins bitboard }
+    // Returns a mask with bit c set for every column c that has a cell in `cells`
+    int cols = 0;
+
+    for (int c = 0; c < COLS; c++) {
+        if (cells & bitboard_column(c)) cols |= 1 << c;
+    }
+    return cols;
+}
+
+/*=======*/
+
+
+#endif /* GAME_BATCH_H */
@@ -0,0 +1,778 @@
+/*
+    Game_bench.c - Engine benchmarks (headless)
+    -------------------------------------------
+    Usage:
+      bench smp [max_threads] [hash_mb]   Lazy SMP speedup on a fixed position set
+      bench perft [depth]                  Move generation / win detection node counts and speed
+      bench geo [depth] [search_depth]     Perft and fixed-depth search on every geometry kernel, checked against the matrix
+      bench simd [positions] [rounds]      Batched legal / win / terminal queries against check_win loops
+      bench eval [positions] [depth]       Static evaluation speed (full rescan vs make/unmake) and a look-ahead
+      bench pns [positions] [plies] [node_budget] [search_ms]
+                                           Time to prove a forced win: df-pn against the alpha-beta search
+
+    Build (MinGW / gcc):
+      gcc -O2 Game_bench.c Game_batch.c Game_board.c Game_eval.c Game_geometry.c Game_pns.c Game_search.c Game_tt.c Game_time.c -o bench -pthread
+
+    Build (MSVC):
+      cl /O2 /std:c11 /experimental:c11atomics Game_bench.c Game_batch.c Game_board.c Game_eval.c Game_geometry.c Game_pns.c Game_search.c Game_tt.c Game_time.c
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Game_batch.h"
+#include "Game_board.h"
+#include "Game_eval.h"
+#include "Game_geometry.h"
+#include "Game_pns.h"
+#include "Game_rng.h"
+#include "Game_search.h"
+#include "Game_tt.h"
+#include "Game_time.h"
+
+
+// ===== Position set ======
+
+// ------ Fixed middle-game positions (moves as 1-based columns) ----
+static const char* bench_positions[] = {
+    "515541215723",
+    "562315615152",
+    "41617557733635",
+    "64364221222621",
+    "1152513511725426",
+    "3344455112",
+    "3246117513",
+};
+
+#define BENCH_POSITIONS ((int)(sizeof(bench_positions) / sizeof(bench_positions[0])))
+
+/*=======*/
+
+
+// ===== Lazy SMP benchmark ======
+
+// ------ Time to solve the position set per thread count ----
+static int bench_smp(int max_threads, int hash_mb) {   // { max_threads - highest worker count, hash_mb - table size }
+    // Solves every position (no time limit) with 1, 2, 4 ... max_threads workers and prints the speedup
+    tt_t* tt = tt_create((size_t)hash_mb, 0);
+    double base_ms = 0;
+
+    if (!tt) {
+        printf("Could not allocate a %d MB transposition table.\n", hash_mb);
+        return 1;
+    }
+
+    printf("Lazy SMP: %d positions, %d MB table, %d logical CPUs\n", BENCH_POSITIONS, hash_mb, search_cpu_count());
+    printf("threads   total ms   speedup   Mnodes/s\n");
+
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > max_threads) threads = max_threads;
+
+        search_params_t params = { SEARCH_MAX_DEPTH, 0, threads, NULL, 0 };
+        double total_ms = 0;
+        uint64_t nodes = 0;
+
+        for (int i = 0; i < BENCH_POSITIONS; i++) {
+            board_t b;
+            search_result_t res;
+
+            if (!board_from_moves(&b, bench_positions[i])) continue;
+
+            tt_clear(tt);
+            search_best_move(&b, &params, tt, &res);
+
+            total_ms += res.ms;
+            nodes += res.nodes;
+        }
+
+        if (threads == 1) base_ms = total_ms;
+
+        printf("%7d %10.1f %9.2fx %10.2f\n", threads, total_ms,
+            (total_ms > 0) ? (base_ms / total_ms) : (0.0),
+            (total_ms > 0) ? ((double)nodes / total_ms / 1000.0) : (0.0));
+
+        if (threads == max_threads) break;
+    }
+
+    tt_destroy(tt);
+    return 0;
+}
+
+/*=======*/
+
+
+// ===== Perft ======
+//
+// Walks every legal move sequence from the empty board to `depth` plies.
+// Games stop at a win or a full board, like real play:
+//   nodes - positions reached at exactly `depth` plies
+//   wins  - games that ended with four in a row within `depth` plies
+//   draws - games that ended on a full board within `depth` plies
+
+typedef struct {
+    uint64_t nodes;
+    uint64_t wins;
+    uint64_t draws;
+} perft_t;
+
+// ------ Known counts (7x6 board) ----
+static const perft_t perft_known[] = {
+    { 1, 0, 0 },
+    { 7, 0, 0 },
+    { 49, 0, 0 },
+    { 343, 0, 0 },
+    { 2401, 0, 0 },
+    { 16807, 0, 0 },
+    { 117649, 0, 0 },
+    { 823536, 13032, 0 },
+    { 5673234, 57462, 0 },
+    { 39394572, 1144344, 0 },
+    { 268031646, 5405402, 0 },
+};
+
+#define PERFT_KNOWN ((int)(sizeof(perft_known) / sizeof(perft_known[0])))
+
+// ------ Reference: the original int matrix kernels ----
+//
+// The board size is a run-time value here, so the same plain loops also
+// check the geometry kernels of every other size.
+
+typedef struct {
+    int* cell;              // rows * cols cells, top row first (0 empty, 1/2 player)
+    int rows;
+    int cols;
+} mx_board_t;
+
+#define MX(m, r, c)     ((m)->cell[(r) * (m)->cols + (c)])
+
+static int mx_drop(const mx_board_t* m, int col, int player) {
+    // Drops a chip into the requested column. Returns landing row, or -1 if column is full.
+    for (int r = m->rows - 1; r >= 0; r--) {
+        if (MX(m, r, col) == 0) {
+            MX(m, r, col) = player;
+            return r;
+        }
+    }
+    return -1;
+}
+
+static int mx_count_dir(const mx_board_t* m, int r, int c, int dr, int dc, int player) {
+    // Counts same-player chips in a direction from (r,c) (excluding starting cell)
+    int cnt = 0;
+    r += dr; c += dc;
+    while (r >= 0 && r < m->rows && c >= 0 && c < m->cols && MX(m, r, c) == player) {
+        cnt++;
+        r += dr; c += dc;
+    }
+    return cnt;
+}
+
+static int mx_check_win(const mx_board_t* m, int r, int c, int player) {
+    // Checks if the last move at (r,c) created a 4-in-a-row
+    int horiz = 1 + mx_count_dir(m, r, c, 0, -1, player) + mx_count_dir(m, r, c, 0, 1, player);
+    int vert = 1 + mx_count_dir(m, r, c, -1, 0, player) + mx_count_dir(m, r, c, 1, 0, player);
+    int diag1 = 1 + mx_count_dir(m, r, c, -1, -1, player) + mx_count_dir(m, r, c, 1, 1, player);
+    int diag2 = 1 + mx_count_dir(m, r, c, -1, 1, player) + mx_count_dir(m, r, c, 1, -1, player);
+
+    return (horiz >= 4 || vert >= 4 || diag1 >= 4 || diag2 >= 4);
+}
+
+static int mx_check_draw(const mx_board_t* m) {
+    // Returns 1 if the board is full (draw), else 0
+    for (int c = 0; c < m->cols; c++) {
+        if (MX(m, 0, c) == 0) return 0;
+    }
+    return 1;
+}
+
+static void perft_matrix(const mx_board_t* m, int depth, int player, perft_t* out) {   // { depth - plies left, player - side to move }
+    // Perft on the matrix board: drop, test, then clear the cell again
+    if (depth == 0) {
+        out->nodes++;
+        return;
+    }
+
+    for (int c = 0; c < m->cols; c++) {
+        int r = mx_drop(m, c, player);
+        if (r < 0) continue;
+
+        if (mx_check_win(m, r, c, player)) {
+            out->wins++;
+            if (depth == 1) out->nodes++;
+        }
+        else if (mx_check_draw(m)) {
+            out->draws++;
+            if (depth == 1) out->nodes++;
+        }
+        else {
+            perft_matrix(m, depth - 1, 3 - player, out);
+        }
+
+        MX(m, r, c) = 0;
+    }
+}
+
+// ------ Bitboard ----
+static void perft_bitboard(const board_t* b, int depth, perft_t* out) {   // { b - position, depth - plies left }
+    // Perft on board_t: O(1) drop, shift-and-AND win test, move-counter draw test
+    int player = board_player_to_move(b);
+
+    if (depth == 0) {
+        out->nodes++;
+        return;
+    }
+
+    for (int c = 0; c < COLS; c++) {
+        if (!board_can_play(b, c)) continue;
+
+        board_t child = *b;
+        board_drop(&child, c, player);
+
+        if (board_has_won(&child, player)) {
+            out->wins++;
+            if (depth == 1) out->nodes++;
+        }
+        else if (board_is_full(&child)) {
+            out->draws++;
+            if (depth == 1) out->nodes++;
+        }
+        else {
+            perft_bitboard(&child, depth - 1, out);
+        }
+    }
+}
+
+// ------ Side by side run ----
+static int bench_perft(int max_depth) {   // { max_depth - deepest perft }
+    // Runs both implementations for depth 1..max_depth, checks them against each other and the known counts
+    int failed = 0;
+
+    printf("depth        nodes        wins   draws   matrix Mn/s   bitboard Mn/s   check\n");
+
+    for (int depth = 1; depth <= max_depth; depth++) {
+        int board[ROWS][COLS] = { { 0 } };
+        mx_board_t m = { &board[0][0], ROWS, COLS };
+        board_t b;
+        perft_t mx = { 0, 0, 0 };
+        perft_t bb = { 0, 0, 0 };
+        double t0, mx_ms, bb_ms;
+        const char* check;
+
+        t0 = time_now_ms();
+        perft_matrix(&m, depth, PLAYER_1, &mx);
+        mx_ms = time_now_ms() - t0;
+
+        board_reset(&b);
+        t0 = time_now_ms();
+        perft_bitboard(&b, depth, &bb);
+        bb_ms = time_now_ms() - t0;
+
+        if (mx.nodes != bb.nodes || mx.wins != bb.wins || mx.draws != bb.draws)  check = "MISMATCH";
+        else if (depth >= PERFT_KNOWN)                                             check = "unknown";
+        else if (bb.nodes != perft_known[depth].nodes
+            || bb.wins != perft_known[depth].wins
+            || bb.draws != perft_known[depth].draws)                              check = "WRONG";
+        else                                                                       check = "ok";
+
+        if (check[0] != 'o' && check[0] != 'u') failed = 1;
+
+        /* Both walks visit the same tree, so the leaf count is a fair work measure for both */
+        printf("%5d %12llu %11llu %7llu %13.1f %15.1f   %s\n", depth,
+            (unsigned long long)bb.nodes, (unsigned long long)bb.wins, (unsigned long long)bb.draws,
+            (mx_ms > 0) ? ((double)mx.nodes / mx_ms / 1000.0) : (0.0),
+            (bb_ms > 0) ? ((double)bb.nodes / bb_ms / 1000.0) : (0.0),
+            check);
+    }
+
+    return failed;
+}
+
+/*=======*/
+
+
+// ===== Geometry kernels ======
+//
+// Every kernel is checked against perft_matrix at its own size: from the
+// empty board, then from random positions that fill the upper rows too (on
+// the __int128 kernels those are the bits past the first 64).
+
+#define GEO_BENCH_POSITIONS 32      // Random positions per kernel
+
+// ------ Random position ----
+static int geo_random_position(const mx_board_t* m, rng_t* rng, uint8_t* moves) {   // { m - cleared matrix of the kernel size, moves - out }
+    // Random moves up to a random length; a move that would end the game is taken back. Returns the move count.
+    int plies = rng_below(rng, m->rows * m->cols - 1);
+    int n = 0;
+
+    while (n < plies) {
+        int c = rng_below(rng, m->cols);
+        int player = 1 + (n & 1);
+        int r = mx_drop(m, c, player);
+
+        if (r < 0) continue;
+        if (mx_check_win(m, r, c, player) || mx_check_draw(m)) {
+            MX(m, r, c) = 0;
+            break;
+        }
+        moves[n++] = (uint8_t)c;
+    }
+    return n;
+}
+
+static int perft_same(const perft_t* a, const geo_perft_t* b) {
+    return a->nodes == b->nodes && a->wins == b->wins && a->draws == b->draws;
+}
+
+// ------ Every specialized kernel through the dispatcher ----
+static int bench_geo(int depth, int search_depth) {   // { depth - perft plies, search_depth - alpha-beta plies }
+    // Perft and an empty-board search on every kernel; the perft counts are checked against
+    // the matrix at the same size (and board_t on the build-time geometry)
+    int sub = (depth > 1) ? (depth / 2) : (1);   /* Perft plies from the random positions */
+    rng_t rng;
+    int failed = 0;
+
+    rng_seed(&rng, 1);
+    printf("geometry  bits        nodes        wins   perft Mn/s   col  score   search Mn/s   check (empty + %d positions)\n",
+        GEO_BENCH_POSITIONS);
+
+    for (int i = 0; i < geo_kernel_count(); i++) {
+        const geo_kernel_t* k = geo_kernel_at(i);
+        int cells[GEO_MAX_ROWS * GEO_MAX_COLS] = { 0 };
+        mx_board_t m = { cells, k->rows, k->cols };
+        perft_t ref = { 0, 0, 0 };
+        geo_perft_t pf = { 0, 0, 0 };
+        uint64_t nodes = 0;
+        int score = 0;
+        int bad = 0;
+        int col;
+        double t0, pf_ms, ab_ms;
+
+        t0 = time_now_ms();
+        k->perft(NULL, 0, depth, &pf);
+        pf_ms = time_now_ms() - t0;
+
+        t0 = time_now_ms();
+        col = k->best_move(NULL, 0, search_depth, &score, &nodes);
+        ab_ms = time_now_ms() - t0;
+
+        perft_matrix(&m, depth, PLAYER_1, &ref);
+        bad += !perft_same(&ref, &pf);
+
+        if (k->cols == COLS && k->rows == ROWS) {
+            perft_t bb = { 0, 0, 0 };
+            board_t b;
+
+            board_reset(&b);
+            perft_bitboard(&b, depth, &bb);
+            bad += !perft_same(&bb, &pf);
+        }
+
+        for (int p = 0; p < GEO_BENCH_POSITIONS; p++) {
+            uint8_t moves[GEO_MAX_COLS * GEO_MAX_ROWS];
+            perft_t a = { 0, 0, 0 };
+            geo_perft_t g = { 0, 0, 0 };
+            int n;
+
+            memset(cells, 0, sizeof(cells));
+            n = geo_random_position(&m, &rng, moves);
+            perft_matrix(&m, sub, 1 + (n & 1), &a);
+            if (!k->perft(moves, n, sub, &g) || !perft_same(&a, &g)) bad++;
+        }
+        if (bad) failed = 1;
+
+        printf("%-8s %5d %12llu %11llu %12.1f %5d %6d %13.1f   %s\n", k->name, k->bits,
+            (unsigned long long)pf.nodes, (unsigned long long)pf.wins,
+            (pf_ms > 0) ? ((double)pf.nodes / pf_ms / 1000.0) : (0.0),
+            col + 1, score,
+            (ab_ms > 0) ? ((double)nodes / ab_ms / 1000.0) : (0.0),
+            (bad) ? "MISMATCH" : "ok");
+    }
+
+    return failed;
+}
+
+/*=======*/
+
+
+// ===== Batched queries ======
+
+typedef struct {
+    int board[ROWS][COLS];  // Matrix copy for the check_win baseline
+    int last_r, last_c;     // Last move (-1 on the empty board)
+    int player;             // Side to move
+} simd_matrix_t;
+
+static uint64_t simd_rng = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t simd_rand(void) {
+    // xorshift64*, good enough to scatter benchmark positions
+    simd_rng ^= simd_rng >> 12;
+    simd_rng ^= simd_rng << 25;
+    simd_rng ^= simd_rng >> 27;
+    return simd_rng * 0x2545F4914F6CDD1DULL;
+}
+
+// ------ Baseline: one board, one cell at a time ----
+static void simd_baseline(simd_matrix_t* m, int player, int* legal, int* wins, int* terminal) {   // { m - position, player - side to move, legal/wins - out column masks }
+    // Legal columns from the top row, wins by dropping and calling check_win, terminal from the last move
+    mx_board_t v = { &m->board[0][0], ROWS, COLS };
+    int over = (m->last_r >= 0 && mx_check_win(&v, m->last_r, m->last_c, 3 - player)) || mx_check_draw(&v);
+
+    *legal = 0;
+    *wins = 0;
+    *terminal = over;
+    if (over) return;
+
+    for (int c = 0; c < COLS; c++) {
+        int r = mx_drop(&v, c, player);
+        if (r < 0) continue;
+
+        *legal |= 1 << c;
+        if (mx_check_win(&v, r, c, player)) *wins |= 1 << c;
+        m->board[r][c] = 0;
+    }
+}
+
+// ------ Speed and agreement of every kernel level ----
+static int bench_simd(size_t count, int rounds) {   // { count - positions per batch, rounds - passes over the batch }
+    // Random positions (finished games included) through the baseline and every batch_eval level
+    uint64_t* own = (uint64_t*)malloc(count * sizeof(*own));
+    uint64_t* opp = (uint64_t*)malloc(count * sizeof(*opp));
+    uint64_t* legal = (uint64_t*)malloc(count * sizeof(*legal));
+    uint64_t* wins = (uint64_t*)malloc(count * sizeof(*wins));
+    uint8_t* terminal = (uint8_t*)malloc(count);
+    int* ref = (int*)malloc(count * 3 * sizeof(*ref));
+    simd_matrix_t* mx = (simd_matrix_t*)calloc(count, sizeof(*mx));
+    batch_t batch = { own, opp, legal, wins, terminal };
+    double base_ms, t0;
+    int failed = 0;
+    volatile int sink = 0;
+
+    if (!own || !opp || !legal || !wins || !terminal || !ref || !mx) {
+        printf("Out of memory.\n");
+        return 1;
+    }
+
+    /* Random games cut at a random length; a game that ends early stays in the set as a terminal position */
+    for (size_t i = 0; i < count; i++) {
+        mx_board_t v = { &mx[i].board[0][0], ROWS, COLS };
+        board_t b;
+        int plies = (int)(simd_rand() % BOARD_CELLS);
+
+        board_reset(&b);
+        mx[i].last_r = mx[i].last_c = -1;
+
+        while (b.moves < plies) {
+            int c = (int)(simd_rand() % COLS);
+            int player = board_player_to_move(&b);
+            int r;
+
+            if (!board_can_play(&b, c)) continue;
+            r = board_drop(&b, c, player);
+            mx_drop(&v, c, player);
+            mx[i].last_r = r;
+            mx[i].last_c = c;
+            if (board_has_won(&b, player)) break;
+        }
+        mx[i].player = board_player_to_move(&b);
+        batch_set(own, opp, i, &b);
+    }
+
+    printf("%zu positions x %d rounds, best kernel: %s\n", count, rounds, batch_level_name(batch_best_level()));
+    printf("kernel        Mpos/s   speedup   check\n");
+
+    t0 = time_now_ms();
+    for (int k = 0; k < rounds; k++) {
+        for (size_t i = 0; i < count; i++) {
+            simd_baseline(&mx[i], mx[i].player, &ref[i * 3], &ref[i * 3 + 1], &ref[i * 3 + 2]);
+            sink += ref[i * 3 + 1];
+        }
+    }
+    base_ms = time_now_ms() - t0;
+    printf("%-10s %9.1f %8.2fx   -\n", "check_win", (base_ms > 0) ? (count * (double)rounds / base_ms / 1000.0) : (0.0), 1.0);
+
+    for (int level = BATCH_SCALAR; level <= batch_best_level(); level++) {
+        size_t bad = 0;
+        double ms;
+
+        t0 = time_now_ms();
+        for (int k = 0; k < rounds; k++) {
+            batch_eval_level(&batch, count, level);
+            sink += (int)wins[k % count];
+        }
+        ms = time_now_ms() - t0;
+
+        for (size_t i = 0; i < count; i++) {
+            if (batch_columns(legal[i]) != ref[i * 3] || batch_columns(wins[i]) != ref[i * 3 + 1] || terminal[i] != ref[i * 3 + 2]) bad++;
+        }
+        if (bad) failed = 1;
+
+        printf("%-10s %9.1f %8.2fx   %s\n", batch_level_name(level),
+            (ms > 0) ? (count * (double)rounds / ms / 1000.0) : (0.0),
+            (ms > 0) ? (base_ms / ms) : (0.0),
+            (bad) ? "MISMATCH" : "ok");
+    }
+
+    free(own); free(opp); free(legal); free(wins); free(terminal); free(ref); free(mx);
+    return failed;
+}
+
+/*=======*/
+
+
+// ===== Static evaluation ======
+
+// ------ Rescan vs incremental, then the look-ahead the HARD AI runs ----
+static int bench_eval(size_t count, int depth) {   // { count - random positions, depth - look-ahead plies }
+    // Scores every child of every position both ways, checks they agree, and times eval_best_move
+    board_t* boards = (board_t*)malloc(count * sizeof(*boards));
+    double t0, full_ms, inc_ms, ab_ms;
+    uint64_t evals = 0, nodes = 0;
+    size_t bad = 0;
+    volatile int sink = 0;
+
+    if (!boards) {
+        printf("Out of memory.\n");
+        return 1;
+    }
+
+    /* Random unfinished positions of every length */
+    for (size_t i = 0; i < count; i++) {
+        board_t* b = &boards[i];
+        int plies = (int)(simd_rand() % (BOARD_CELLS - 1));
+
+        board_reset(b);
+        while (b->moves < plies) {
+            int c = (int)(simd_rand() % COLS);
+            int player = board_player_to_move(b);
+
+            if (!board_can_play(b, c)) continue;
+            board_drop(b, c, player);
+            if (board_has_won(b, player)) {
+                board_undo(b, c);
+                break;
+            }
+        }
+    }
+
+    t0 = time_now_ms();
+    for (size_t i = 0; i < count; i++) {
+        for (int c = 0; c < COLS; c++) {
+            if (!board_can_play(&boards[i], c)) continue;
+
+            board_t child = boards[i];
+            board_drop(&child, c, board_player_to_move(&child));
+            sink += eval_full(&child);
+            evals++;
+        }
+    }
+    full_ms = time_now_ms() - t0;
+
+    /* A search resets once per root and then only makes and unmakes moves: time that part */
+    inc_ms = 0;
+    for (size_t i = 0; i < count; i++) {
+        eval_pos_t p;
+
+        eval_reset(&p, &boards[i]);
+        t0 = time_now_ms();
+        for (int c = 0; c < COLS; c++) {
+            if (!board_can_play(&p.b, c)) continue;
+
+            eval_play(&p, c);
+            sink += p.score;
+            eval_undo(&p, c);
+        }
+        inc_ms += time_now_ms() - t0;
+    }
+
+    /* Agreement, untimed */
+    for (size_t i = 0; i < count; i++) {
+        eval_pos_t p;
+
+        eval_reset(&p, &boards[i]);
+        for (int c = 0; c < COLS; c++) {
+            if (!board_can_play(&p.b, c)) continue;
+
+            eval_play(&p, c);
+            if (p.score != eval_full(&p.b)) bad++;
+            eval_undo(&p, c);
+        }
+        if (p.score != eval_full(&boards[i])) bad++;
+    }
+
+    t0 = time_now_ms();
+    for (size_t i = 0; i < count && i < 2000; i++) {
+        uint64_t n = 0;
+        sink += eval_best_move(&boards[i], depth, NULL, &n);
+        nodes += n;
+    }
+    ab_ms = time_now_ms() - t0;
+
+    printf("%zu positions, %llu child evaluations\n", count, (unsigned long long)evals);
+    printf("  full rescan       %8.2f Meval/s\n", (full_ms > 0) ? (evals / full_ms / 1000.0) : (0.0));
+    printf("  make/eval/unmake  %8.2f Meval/s   (%.1fx)   %s\n", (inc_ms > 0) ? (evals / inc_ms / 1000.0) : (0.0),
+        (inc_ms > 0) ? (full_ms / inc_ms) : (0.0), (bad) ? ("MISMATCH") : ("ok"));
+    printf("  %d-ply look-ahead  %8.2f ms/move, %.2f Mnodes/s\n", depth,
+        ab_ms / (double)((count < 2000) ? count : 2000), (ab_ms > 0) ? (nodes / ab_ms / 1000.0) : (0.0));
+
+    free(boards);
+    return bad != 0;
+}
+
+/*=======*/
+
+
+// ===== Proof-number search ======
+
+// ------ Time to proof, df-pn vs alpha-beta ----
+static int bench_pns(int count, int plies, uint64_t budget, int search_ms) {   // { count - positions, plies - random moves, budget - df-pn nodes, search_ms - search cap }
+    // Runs both provers on the same random positions, each from an empty table, and compares
+    // the time each needs to show a forced win for the side to move
+    tt_t* tt = tt_create(TT_DEFAULT_MB, 0);
+    pns_t* pns = pns_create(PNS_DEFAULT_MB);
+    search_params_t params = { SEARCH_MAX_DEPTH, search_ms, 1, NULL, 0 };
+    int pns_wins = 0, search_wins = 0, both = 0, disproved = 0, unknown = 0, disagree = 0, faster = 0;
+    double pns_ms = 0, both_pns_ms = 0, both_search_ms = 0;
+    uint64_t pns_nodes = 0;
+
+    if (!tt || !pns) {
+        printf("Out of memory.\n");
+        return 1;
+    }
+
+    printf("df-pn vs alpha-beta: %d positions after %d random plies, %llu node budget, %d ms search cap\n",
+        count, plies, (unsigned long long)budget, search_ms);
+    printf("  position                              df-pn          nodes        ms     search        ms\n");
+
+    for (int i = 0; i < count; ) {
+        board_t b;
+        char moves[BOARD_CELLS + 1];
+        pns_result_t pr;
+        search_result_t sr;
+        int ended = 0, search_won;
+
+        board_reset(&b);
+        while (b.moves < plies) {
+            int c = (int)(simd_rand() % COLS);
+            int player = board_player_to_move(&b);
+
+            if (!board_can_play(&b, c)) continue;
+            moves[b.moves] = (char)('1' + c);
+            board_drop(&b, c, player);
+            if (board_has_won(&b, player) || board_is_full(&b)) {
+                ended = 1;
+                break;
+            }
+        }
+        if (ended || board_winning_moves(&b, board_player_to_move(&b))) continue;   /* Nothing to prove */
+        moves[b.moves] = '\0';
+        i++;
+
+        pns_clear(pns);
+        pns_prove(pns, &b, budget, 0, &pr);
+        tt_clear(tt);
+        search_best_move(&b, &params, tt, &sr);
+        search_won = (sr.score >= SEARCH_WIN_MIN);
+
+        pns_ms += pr.ms;
+        pns_nodes += pr.nodes;
+        if (pr.result == PNS_PROVEN) pns_wins++;
+        else if (pr.result == PNS_DISPROVEN) disproved++;
+        else unknown++;
+        if (search_won) search_wins++;
+        if ((pr.result == PNS_PROVEN && sr.score < SEARCH_WIN_MIN && sr.depth >= BOARD_CELLS - b.moves)
+            || (pr.result == PNS_DISPROVEN && search_won)) disagree++;
+
+        if (pr.result == PNS_PROVEN && search_won) {
+            both++;
+            both_pns_ms += pr.ms;
+            both_search_ms += sr.ms;
+            if (pr.ms < sr.ms) faster++;
+        }
+
+        printf("  %-36s %-10s %10llu %9.2f     %-6s %9.2f\n", moves,
+            (pr.result == PNS_PROVEN) ? ("win") : (pr.result == PNS_DISPROVEN) ? ("no win") : ("unknown"),
+            (unsigned long long)pr.nodes, pr.ms, (search_won) ? ("win") : ("-"), sr.ms);
+    }
+
+    printf("df-pn: %d proven, %d disproven, %d over budget; %.2f Mnodes/s\n", pns_wins, disproved, unknown,
+        (pns_ms > 0) ? (pns_nodes / pns_ms / 1000.0) : (0.0));
+    printf("search: %d forced wins within %d ms\n", search_wins, search_ms);
+    printf("wins both found: %d, df-pn %.1f ms vs search %.1f ms (%.2fx), df-pn faster on %d   %s\n", both,
+        both_pns_ms, both_search_ms, (both_pns_ms > 0) ? (both_search_ms / both_pns_ms) : (0.0), faster,
+        (disagree) ? ("MISMATCH") : ("ok"));
+
+    pns_destroy(pns);
+    tt_destroy(tt);
+    return disagree != 0;
+}
+
+/*=======*/
+
+
+// ===== Main function ======
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && !strcmp(argv[1], "perft")) {
+        int depth = (argc >= 3) ? atoi(argv[2]) : 8;
+        if (depth < 1) depth = 1;
+        if (depth > BOARD_CELLS) depth = BOARD_CELLS;
+        return bench_perft(depth);
+    }
+
+    if (argc >= 2 && !strcmp(argv[1], "geo")) {
+        int depth = (argc >= 3) ? atoi(argv[2]) : 8;
+        int search_depth = (argc >= 4) ? atoi(argv[3]) : 12;
+        if (depth < 1) depth = 1;
+        if (search_depth < 1) search_depth = 1;
+        return bench_geo(depth, search_depth);
+    }
+
+    if (argc >= 2 && !strcmp(argv[1], "simd")) {
+        long count = (argc >= 3) ? atol(argv[2]) : 65536;
+        int rounds = (argc >= 4) ? atoi(argv[3]) : 50;
+        if (count < 1) count = 1;
+        if (rounds < 1) rounds = 1;
+        return bench_simd((size_t)count, rounds);
+    }
+
+    if (argc >= 2 && !strcmp(argv[1], "eval")) {
+        long count = (argc >= 3) ? atol(argv[2]) : 200000;
+        int depth = (argc >= 4) ? atoi(argv[3]) : 6;
+        if (count < 1) count = 1;
+        if (depth < 1) depth = 1;
+        return bench_eval((size_t)count, depth);
+    }
+
+    if (argc >= 2 && !strcmp(argv[1], "pns")) {
+        int count = (argc >= 3) ? atoi(argv[2]) : 50;
+        int plies = (argc >= 4) ? atoi(argv[3]) : 16;
+        long long budget = (argc >= 5) ? atoll(argv[4]) : 2000000;
+        int search_ms = (argc >= 6) ? atoi(argv[5]) : 5000;
+        if (count < 1) count = 1;
+        if (plies < 0) plies = 0;
+        if (plies > BOARD_CELLS - 2) plies = BOARD_CELLS - 2;
+        if (budget < 1) budget = 1;
+        if (search_ms < 1) search_ms = 1;
+        return bench_pns(count, plies, (uint64_t)budget, search_ms);
+    }
+
+    if (argc >= 2 && !strcmp(argv[1], "smp")) {
+        int max_threads = (argc >= 3) ? atoi(argv[2]) : search_cpu_count();
+        int hash_mb = (argc >= 4) ? atoi(argv[3]) : TT_DEFAULT_MB;
+
+        if (max_threads < 1) max_threads = 1;
+        if (max_threads > SEARCH_MAX_THREADS) max_threads = SEARCH_MAX_THREADS;
+        return bench_smp(max_threads, hash_mb);
+    }
+
+    printf("usage: %s smp [max_threads] [hash_mb]\n", argv[0]);
+    printf("       %s perft [depth]\n", argv[0]);
+    printf("       %s geo [depth] [search_depth]\n", argv[0]);
+    printf("       %s simd [positions] [rounds]\n", argv[0]);
+    printf("       %s eval [positions] [depth]\n", argv[0]);
+    printf("       %s pns [positions] [plies] [node_budget] [search_ms]\n", argv[0]);
+    return 1;
+}
+
+/*=======*/
@@ -0,0 +1,127 @@
+#include <string.h>
+#include "Game_board.h"
+
+
+// ===== Board state functions ======
+
+// ------ Reset ----
+void board_reset(board_t* b) {   // { b - board to clear }
+    // Empties both bitboards and the column heights
+    memset(b, 0, sizeof(*b));
+}
+
+// ------ Cell lookup ----
+int board_cell(const board_t* b, int r, int c) {   // { r - screen row (0 top), c - column }
+    // Returns the owner of cell (r,c): CELL_EMPTY, PLAYER_1 or PLAYER_2
+    bitboard_t bit = bitboard_cell(r, c);
+
+    if (b->chips[0] & bit) return PLAYER_1;
+    if (b->chips[1] & bit) return PLAYER_2;
+    return CELL_EMPTY;
+}
+
+// ------ Chip dropping ----
+int board_drop(board_t* b, int col, int player) {   // { col - chosen column, player - 1/2 }
+    // Drops a chip into col in O(1). Returns the landing screen row, or -1 if the column is full.
+    if (col < 0 || col >= COLS || !board_can_play(b, col)) return -1;
+
+    b->chips[player - 1] |= (bitboard_t)1 << (col * BOARD_H1 + b->height[col]);
+    b->height[col]++;
+    b->moves++;
+
+    return ROWS - b->height[col];
+}
+
+// ------ Chip removal ----
+void board_undo(board_t* b, int col) {   // { col - column whose top chip was the last move }
+    // Reverses board_drop in O(1); the column must not be empty
+    bitboard_t bit = (bitboard_t)1 << (col * BOARD_H1 + b->height[col] - 1);
+
+    b->chips[0] &= ~bit;
+    b->chips[1] &= ~bit;
+    b->height[col]--;
+    b->moves--;
+}
+
+// ------ Key decoding ----
+void board_from_key(board_t* b, uint64_t key) {   // { b - board to fill, key - board_key() value }
+    // Inverse of board_key(): every column field is (2^height - 1) + Player 1 chips of that column
+    const uint64_t field = ((uint64_t)1 << BOARD_H1) - 1;
+
+    board_reset(b);
+
+    for (int c = 0; c < COLS; c++) {
+        uint64_t f = (key >> (c * BOARD_H1)) & field;
+        uint64_t mask, p1;
+        int h = 0;
+
+        while (((uint64_t)2 << h) <= f + 1) h++;    /* 2^h - 1 <= f < 2^(h + 1) - 1 */
+
+        mask = ((uint64_t)1 << h) - 1;
+        p1 = f - mask;
+        b->chips[0] |= (bitboard_t)p1 << (c * BOARD_H1);
+        b->chips[1] |= (bitboard_t)(mask & ~p1) << (c * BOARD_H1);
+        b->height[c] = h;
+        b->moves += h;
+    }
+}
+
+// ------ Move strings ----
+int board_from_moves(board_t* b, const char* moves) {   // { b - board to fill, moves - "4453..." }
+    // Plays a 1-based column string from the empty board. Returns 0 on an illegal or game-ending move.
+    board_reset(b);
+
+    for (; *moves; moves++) {
+        int col = *moves - '1';
+        int player = board_player_to_move(b);
+
+        if (board_drop(b, col, player) < 0) return 0;
+        if (board_has_won(b, player)) return 0;
+    }
+    return 1;
+}
+
+/*=======*/
+
+
+// ===== Move history functions ======
+
+void board_history_reset(board_history_t* h) {   // { h - history to clear }
+    board_reset(&h->board);
+    h->last = 0;
+}
+
+int board_history_play(board_history_t* h, int col) {   // { col - chosen column }
+    // Plays a new move; any undone moves after it are forgotten
+    int row = board_drop(&h->board, col, board_player_to_move(&h->board));
+
+    if (row >= 0) {
+        h->cols[h->board.moves - 1] = (uint8_t)col;
+        h->last = h->board.moves;
+    }
+    return row;
+}
+
+int board_history_undo(board_history_t* h) {
+    // Removes the top chip of the last move's column
+    int col;
+
+    if (h->board.moves == 0) return -1;
+
+    col = h->cols[h->board.moves - 1];
+    board_undo(&h->board, col);
+    return col;
+}
+
+int board_history_redo(board_history_t* h) {
+    // Drops the next recorded column again (the side to move is the one that played it)
+    int col;
+
+    if (h->board.moves >= h->last) return -1;
+
+    col = h->cols[h->board.moves];
+    board_drop(&h->board, col, board_player_to_move(&h->board));
+    return col;
+}
+
+/*=======*/
@@ -0,0 +1,239 @@
+#ifndef GAME_BOARD_H
+#define GAME_BOARD_H
+
+#include <stdint.h>
+#include "Config.h"
+
+
+// ===== Bitboard layout ======
+//
+// Each column owns ROWS + 1 consecutive bits, bottom cell first. The extra
+// bit on top of every column stays empty, so shifts never carry a line from
+// one column into the next:
+//
+//   col:   0   1   2   3   4   5   6
+//          6  13  20  27  34  41  48   <- guard bits
+//          5  12  19  26  33  40  47   <- top row    (screen row 0)
+//          ...
+//          0   7  14  21  28  35  42   <- bottom row (screen row ROWS - 1)
+
+#define BOARD_H1        (ROWS + 1)      // Bits per column (incl. guard bit)
+#define BOARD_CELLS     (ROWS * COLS)
+
+#define BOARD_BOTTOM    ((((bitboard_t)1 << (COLS * BOARD_H1)) - 1) / (((bitboard_t)1 << BOARD_H1) - 1))   // Bottom bit of every column
+#define BOARD_MASK      (BOARD_BOTTOM * (((bitboard_t)1 << ROWS) - 1))                                     // Every playable bit
+
+typedef uint64_t bitboard_t;
+
+typedef struct {
+    bitboard_t chips[2];    // { chips[0] - Player 1 chips, chips[1] - Player 2 chips }
+    int height[COLS];       // Number of chips in every column
+    int moves;              // Number of chips on the board
+} board_t;
+
+// ------ Move history ----
+// The columns played since the empty board. Undo only moves the board back;
+// the columns stay recorded, so redo can replay them until a new move is
+// played over them.
+typedef struct {
+    board_t board;                  // Current position
+    uint8_t cols[BOARD_CELLS];      // Column of every move; cols[board.moves .. last - 1] can be redone
+    int last;                       // Moves recorded (redo limit)
+} board_history_t;
+
+/*=======*/
+
+
+// ===== Bitboard helpers ======
+
+// ------ Cell / column masks ----
+static inline bitboard_t bitboard_cell(int r, int c) {   // { r - screen row (0 top), c - column }
+    // Returns the bit of screen cell (r,c)
+    return (bitboard_t)1 << (c * BOARD_H1 + (ROWS - 1 - r));
+}
+
+static inline bitboard_t bitboard_column(int c) {   // { c - column }
+    // Returns all playable bits of column c
+    return (((bitboard_t)1 << ROWS) - 1) << (c * BOARD_H1);
+}
+
+// ------ Four-in-a-row detection ----
+static inline int bitboard_has_four(bitboard_t bb) {   // { bb - chips of one player }
+    // Returns 1 if bb contains 4 aligned chips (shift-and-AND per direction)
+    bitboard_t m;
+
+    m = bb & (bb >> BOARD_H1);          /* horizontal */
+    if (m & (m >> (2 * BOARD_H1))) return 1;
+
+    m = bb & (bb >> (BOARD_H1 - 1));    /* diagonal \ */
+    if (m & (m >> (2 * (BOARD_H1 - 1)))) return 1;
+
+    m = bb & (bb >> (BOARD_H1 + 1));    /* diagonal / */
+    if (m & (m >> (2 * (BOARD_H1 + 1)))) return 1;
+
+    m = bb & (bb >> 1);                 /* vertical */
+    if (m & (m >> 2)) return 1;
+
+    return 0;
+}
+
+// ------ Winning cells ----
+static inline bitboard_t bitboard_winning_cells(bitboard_t own, bitboard_t occupied) {   // { own - chips of one player, occupied - all chips }
+    // Returns every empty cell (playable now or not) that would complete four for own.
+    // Per direction the cell is found as the end or the gap of three chips in a line.
+    static const int dirs[3] = { BOARD_H1, BOARD_H1 - 1, BOARD_H1 + 1 };   /* horizontal, \, / */
+    bitboard_t r = (own << 1) & (own << 2) & (own << 3);                   /* vertical: only on top */
+
+    for (int i = 0; i < 3; i++) {
+        int d = dirs[i];
+        bitboard_t p;
+
+        p = (own << d) & (own << (2 * d));          /* two chips on the left / below */
+        r |= p & (own << (3 * d));
+        r |= p & (own >> d);
+
+        p = (own >> d) & (own >> (2 * d));          /* two chips on the right / above */
+        r |= p & (own >> (3 * d));
+        r |= p & (own << d);
+    }
+    return r & (BOARD_MASK ^ occupied);
+}
+
+/*=======*/
+
+
+// ===== Board functions ======
+
+// ------ Board state ----
+void board_reset(board_t* b);                              // Empties the board
+int  board_cell(const board_t* b, int r, int c);           // { r - screen row, c - column } CELL_EMPTY / PLAYER_1 / PLAYER_2
+int  board_drop(board_t* b, int col, int player);          // { col - column, player - 1/2 } Landing row or -1 if full
+void board_undo(board_t* b, int col);                      // { col - column of the last chip } Takes the top chip back out
+int  board_from_moves(board_t* b, const char* moves);      // { moves - 1-based columns, e.g. "4453" } 0 if illegal or the game ends
+void board_from_key(board_t* b, uint64_t key);             // { key - board_key() value } Rebuilds the position
+
+// ------ Move history ----
+void board_history_reset(board_history_t* h);              // Empty board, nothing to redo
+int  board_history_play(board_history_t* h, int col);      // { col - column } Plays for the side to move; landing row or -1. Clears redo.
+int  board_history_undo(board_history_t* h);               // Takes back the last move in O(1). Its column, or -1 if none.
+int  board_history_redo(board_history_t* h);               // Replays the next undone move in O(1). Its column, or -1 if none.
+
+// ------ Board queries ----
+static inline int board_can_play(const board_t* b, int col) {   // { col - column }
+    // Returns 1 if column col has a free cell
+    return b->height[col] < ROWS;
+}
+
+static inline bitboard_t board_playable(const board_t* b) {
+    // Returns the landing cell of every non-full column (a full column carries into its guard bit)
+    return ((b->chips[0] | b->chips[1]) + BOARD_BOTTOM) & BOARD_MASK;
+}
+
+static inline bitboard_t board_winning_moves(const board_t* b, int player) {   // { player - 1/2 }
+    // Returns the landing cells where player would complete four right now
+    return bitboard_winning_cells(b->chips[player - 1], b->chips[0] | b->chips[1]) & board_playable(b);
+}
+
+static inline bitboard_t board_safe_moves(const board_t* b) {
+    // Landing cells the side to move can play without losing on the next move. Assumes it
+    // cannot win itself (check board_winning_moves first). 0 - every move loses.
+    int opp = (b->moves & 1) ? 0 : 1;
+    bitboard_t threats = bitboard_winning_cells(b->chips[opp], b->chips[0] | b->chips[1]);
+    bitboard_t moves = board_playable(b);
+    bitboard_t forced = moves & threats;
+
+    if (forced) {
+        if (forced & (forced - 1)) return 0;    /* Two threats: blocking one leaves the other */
+        moves = forced;
+    }
+    return moves & ~(threats >> 1);             /* Never fill the cell under an opponent threat */
+}
+
+static inline unsigned board_column_mask(const board_t* b) {
+    // Returns bit c set for every column c that still has a free cell
+    unsigned m = 0;
+    for (int c = 0; c < COLS; c++) m |= (unsigned)(b->height[c] < ROWS) << c;
+    return m;
+}
+
+static inline int board_move_column(bitboard_t moves) {   // { moves - landing cells (0 - none) }
+    // Returns the lowest column with a cell in moves, or -1
+    for (int c = 0; c < COLS; c++) {
+        if (moves & bitboard_column(c)) return c;
+    }
+    return -1;
+}
+
+static inline int board_landing_row(const board_t* b, int col) {   // { col - column }
+    // Returns the screen row a chip dropped in col would land on, or -1 if full
+    return ROWS - 1 - b->height[col];
+}
+
+static inline int board_has_won(const board_t* b, int player) {   // { player - 1/2 }
+    // Returns 1 if player has 4 chips in a row
+    return bitboard_has_four(b->chips[player - 1]);
+}
+
+static inline int board_is_full(const board_t* b) {
+    // Returns 1 if no more moves are possible (draw unless somebody won)
+    return b->moves == BOARD_CELLS;
+}
+
+static inline uint64_t board_key(const board_t* b) {
+    // Unique position key: Player 1 chips + occupied cells. Each column field
+    // becomes (2^height - 1) + chips, which never carries into the guard bit.
+    return b->chips[0] + (b->chips[0] | b->chips[1]);
+}
+
+static inline int board_player_to_move(const board_t* b) {
+    // Player 1 always opens, so the side to move follows the move counter
+    return (b->moves & 1) ? PLAYER_2 : PLAYER_1;
+}
+
+/*=======*/
+
+
+// ===== Symmetry ======
+//
+// A position and its mirror image about the center column have the same
+// value, and a move c in one is move COLS - 1 - c in the other. Tables that
+// key by board_canonical_key() (the smaller of the two keys) hold one entry
+// per pair and store moves for the canonical orientation; board_mirror_col()
+// maps a move between the two on the way in and out.
+//
+// board_key() keeps one BOARD_H1-bit field per column, so mirroring the
+// position is reversing the order of the fields; the bits inside a field
+// never move.
+
+static inline uint64_t board_mirror_key(uint64_t key) {   // { key - board_key() value }
+    // Key of the mirror image: field c swaps with field COLS - 1 - c, the center stays
+    const uint64_t field = ((uint64_t)1 << BOARD_H1) - 1;
+    uint64_t m = (COLS & 1) ? (key & (field << ((COLS / 2) * BOARD_H1))) : 0;
+
+    for (int c = 0; c < COLS / 2; c++) {
+        int d = (COLS - 1 - 2 * c) * BOARD_H1;  /* Distance between the two fields */
+        uint64_t lo = field << (c * BOARD_H1);
+
+        m |= ((key & lo) << d) | ((key >> d) & lo);
+    }
+    return m;
+}
+
+static inline uint64_t board_canonical_key(const board_t* b, int* mirrored) {   // { mirrored - out: 1 if the mirror image gave the key }
+    // Returns the smaller of board_key() and the key of the mirror image
+    uint64_t key = board_key(b);
+    uint64_t m = board_mirror_key(key);
+
+    *mirrored = (m < key);
+    return (m < key) ? m : key;
+}
+
+static inline int board_mirror_col(int col, int mirrored) {   // { col - column, mirrored - from board_canonical_key() }
+    // Maps a column between a position and its canonical orientation (the same map both ways)
+    return (mirrored) ? (COLS - 1 - col) : (col);
+}
+
+/*=======*/
+
+
+#endif /* GAME_BOARD_H */
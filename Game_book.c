@@ -0,0 +1,184 @@
+#ifndef _WIN32
+#define _DEFAULT_SOURCE     // madvise under strict -std=c11
+#endif
+
+#include <stdlib.h>
+#include "Game_book.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+// ===== Book state ======
+
+struct book_s {
+    const void* map;            // Whole file, read-only mapping
+    size_t size;                // Mapped bytes
+    const book_header_t* hdr;   // Header at offset 0
+    const uint64_t* keys;       // Sorted keys right after the header
+    const uint32_t* data;       // Entry data after the keys
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+/*=======*/
+
+
+// ===== Keys ======
+
+// ------ Canonical key ----
+uint64_t book_key(const board_t* b, int* mirrored) {   // { b - position, mirrored - out (can be NULL) }
+    // Returns the smaller of the position key and the key of its mirror image (board_canonical_key)
+    int m;
+    uint64_t key = board_canonical_key(b, &m);
+
+    if (mirrored) *mirrored = m;
+    return key;
+}
+
+/*=======*/
+
+
+// ===== Memory mapping ======
+
+// ------ Open ----
+book_t* book_open(const char* path) {   // { path - book file }
+    // Maps the file read-only; pages are only read when a probe touches them
+    book_t* book = (book_t*)calloc(1, sizeof(*book));
+    if (!book) return NULL;
+
+#ifdef _WIN32
+    LARGE_INTEGER size;
+
+    book->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+    if (book->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(book->file, &size)) {
+        if (book->file != INVALID_HANDLE_VALUE) CloseHandle(book->file);
+        free(book);
+        return NULL;
+    }
+
+    book->size = (size_t)size.QuadPart;
+    book->mapping = (book->size) ? CreateFileMappingA(book->file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    book->map = (book->mapping) ? MapViewOfFile(book->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+    if (!book->map) {
+        if (book->mapping) CloseHandle(book->mapping);
+        CloseHandle(book->file);
+        free(book);
+        return NULL;
+    }
+#else
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size <= 0) {
+        if (fd >= 0) close(fd);
+        free(book);
+        return NULL;
+    }
+
+    book->size = (size_t)st.st_size;
+    book->map = mmap(NULL, book->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   /* The mapping keeps the file alive */
+
+    if (book->map == MAP_FAILED) {
+        free(book);
+        return NULL;
+    }
+#ifdef MADV_RANDOM
+    madvise((void*)book->map, book->size, MADV_RANDOM);   /* Binary search: no read-ahead */
+#endif
+#endif
+
+    book->hdr = (const book_header_t*)book->map;
+    book->keys = (const uint64_t*)(book->hdr + 1);
+    book->data = (const uint32_t*)(book->keys + ((book->size >= sizeof(book_header_t)) ? book->hdr->count : 0));
+
+    /* Reject foreign files, other geometries and truncated books */
+    if (book->size < sizeof(book_header_t)
+        || book->hdr->magic != BOOK_MAGIC
+        || book->hdr->version != BOOK_VERSION
+        || book->hdr->rows != ROWS
+        || book->hdr->cols != COLS
+        || book->size < sizeof(book_header_t) + (size_t)book->hdr->count * (sizeof(uint64_t) + sizeof(uint32_t))) {
+        book_close(book);
+        return NULL;
+    }
+
+    return book;
+}
+
+// ------ Close ----
+void book_close(book_t* book) {
+    // Unmaps the file and frees the handle
+    if (!book) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(book->map);
+    CloseHandle(book->mapping);
+    CloseHandle(book->file);
+#else
+    munmap((void*)book->map, book->size);
+#endif
+
+    free(book);
+}
+
+/*=======*/
+
+
+// ===== Lookup ======
+
+// ------ Probe ----
+int book_probe(const book_t* book, const board_t* b, int* col, int* score, int* exact) {   // { b - position, col/score/exact - out }
+    // Binary-searches the canonical key. Returns 1 and the stored move (in b's orientation) if found;
+    // *exact tells a proven entry from a depth-limited estimate.
+    int mirrored;
+    uint64_t key;
+    uint32_t lo = 0;
+    uint32_t hi;
+
+    if (!book || b->moves > (int)book->hdr->max_ply) return 0;
+
+    key = book_key(b, &mirrored);
+    hi = book->hdr->count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (book->keys[mid] < key) lo = mid + 1;
+        else                       hi = mid;
+    }
+
+    if (lo == book->hdr->count || book->keys[lo] != key) return 0;
+
+    uint32_t d = book->data[lo];
+    int c = (int)((d >> 16) & 0xFF);
+
+    if (c >= COLS) return 0;
+
+    *col = board_mirror_col(c, mirrored);
+    if (score) *score = (int)(d & 0xFFFF) - 32768;
+    if (exact) *exact = ((d >> 24) & BOOK_EXACT) != 0;
+
+    return board_can_play(b, *col);
+}
+
+// ------ Info ----
+int book_count(const book_t* book) {
+    return (book) ? (int)book->hdr->count : 0;
+}
+
+int book_max_ply(const book_t* book) {
+    return (book) ? (int)book->hdr->max_ply : 0;
+}
+
+/*=======*/
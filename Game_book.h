@@ -0,0 +1,56 @@
+#ifndef GAME_BOOK_H
+#define GAME_BOOK_H
+
+#include <stdint.h>
+#include "Game_board.h"
+
+
+// ===== Book file format ======
+//
+//   book_header_t                      32 bytes
+//   uint64_t keys[count]               canonical position keys, sorted ascending
+//   uint32_t data[count]               packed entry for keys[i]
+//
+// A position and its mirror image share one entry: the key is the smaller of
+// board_key() and its mirrored key, and the move is stored for that
+// orientation. data bits: 0..15 score + 32768 | 16..23 column | 24..30 depth | 31 exact
+
+#define BOOK_MAGIC          0x4B423443u    // "C4BK"
+#define BOOK_VERSION        1
+#define BOOK_DEFAULT_PATH   "connect4.book"
+
+#define BOOK_EXACT          0x80           // Score is a proven result, not a depth-limited estimate
+
+typedef struct {
+    uint32_t magic;         // BOOK_MAGIC
+    uint32_t version;       // BOOK_VERSION
+    uint32_t rows;          // Board geometry the book was built for
+    uint32_t cols;
+    uint32_t max_ply;       // Deepest ply stored
+    uint32_t count;         // Number of entries
+    uint32_t reserved[2];
+} book_header_t;
+
+typedef struct book_s book_t;
+
+/*=======*/
+
+
+// ===== Book functions ======
+
+// ------ Keys ----
+uint64_t book_key(const board_t* b, int* mirrored);    // { mirrored - out: 1 if the mirror image gave the key } Canonical key
+
+// ------ Lifetime ----
+book_t* book_open(const char* path);                   // Memory-maps a book file. NULL if missing or invalid.
+void    book_close(book_t* book);                      // Unmaps the file (NULL is ignored)
+
+// ------ Lookup ----
+int book_probe(const book_t* book, const board_t* b, int* col, int* score, int* exact);   // { col/score/exact - out (score/exact can be NULL) } 1 if found
+int book_count(const book_t* book);                    // Entries in the book
+int book_max_ply(const book_t* book);                  // Deepest ply covered
+
+/*=======*/
+
+
+#endif /* GAME_BOOK_H */
@@ -0,0 +1,305 @@
+/*
+    Game_book_gen.c - Opening book generator (offline)
+    --------------------------------------------------
+    Enumerates every position reachable in max_ply moves, folds mirror
+    images together, solves each one exactly (Game_solve.c) and writes the
+    sorted binary book that Game_book.c memory-maps. Every entry is
+    BOOK_EXACT: its move keeps the game-theoretic value.
+
+    Usage:
+      book_gen [out_file] [max_ply] [threads] [hash_mb] [--search <ms>]
+      (defaults: connect4.book 4 <all CPUs> 1024)
+
+    Workers solve one position each and share the table; the deepest
+    positions go first so the shallow ones start from their bounds. Exact
+    books are slow to build: expect hours of CPU time for ply 4 on 7x6.
+
+    --search <ms> is a fallback for quick books: a time-limited search per
+    position instead of the solver. Only the results it happens to prove
+    are flagged BOOK_EXACT; the game treats the rest as move hints.
+
+    Build (MinGW / gcc):
+      gcc -O2 Game_book_gen.c Game_book.c Game_board.c Game_search.c Game_solve.c Game_tt.c Game_time.c -o book_gen -pthread
+*/
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include "Game_board.h"
+#include "Game_book.h"
+#include "Game_search.h"
+#include "Game_solve.h"
+#include "Game_tt.h"
+#include "Game_time.h"
+
+
+// ===== Position list ======
+
+typedef struct {
+    uint64_t key;           // Canonical key
+    board_t board;          // One of the two mirror images
+    int mirrored;           // 1 if board is the mirror of the canonical orientation
+} gen_pos_t;
+
+static gen_pos_t* positions = NULL;
+static size_t pos_count = 0;
+static size_t pos_cap = 0;
+
+static int push_position(const board_t* b) {   // { b - position to add }
+    // Appends b with its canonical key. Returns 0 when out of memory.
+    if (pos_count == pos_cap) {
+        size_t cap = (pos_cap) ? (pos_cap * 2) : (1024);
+        gen_pos_t* p = (gen_pos_t*)realloc(positions, cap * sizeof(*p));
+        if (!p) return 0;
+        positions = p;
+        pos_cap = cap;
+    }
+
+    positions[pos_count].board = *b;
+    positions[pos_count].key = book_key(b, &positions[pos_count].mirrored);
+    pos_count++;
+    return 1;
+}
+
+// ------ Enumeration ----
+static int enumerate(const board_t* b, int max_ply) {   // { b - current position, max_ply - deepest ply to store }
+    // Collects every non-terminal position up to max_ply plies (duplicates are removed later)
+    int player = board_player_to_move(b);
+
+    if (!push_position(b)) return 0;
+    if (b->moves == max_ply) return 1;
+
+    for (int c = 0; c < COLS; c++) {
+        if (!board_can_play(b, c)) continue;
+
+        board_t child = *b;
+        board_drop(&child, c, player);
+        if (board_has_won(&child, player) || board_is_full(&child)) continue;
+
+        if (!enumerate(&child, max_ply)) return 0;
+    }
+    return 1;
+}
+
+static int cmp_key(const void* a, const void* b) {
+    uint64_t ka = ((const gen_pos_t*)a)->key;
+    uint64_t kb = ((const gen_pos_t*)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+static void sort_unique(void) {
+    // Sorts by canonical key and keeps one position per symmetry class
+    size_t n = 0;
+
+    qsort(positions, pos_count, sizeof(*positions), cmp_key);
+
+    for (size_t i = 0; i < pos_count; i++) {
+        if (n == 0 || positions[i].key != positions[n - 1].key) positions[n++] = positions[i];
+    }
+    pos_count = n;
+}
+
+/*=======*/
+
+
+// ===== Entries ======
+
+static uint64_t* keys = NULL;           // Output, in positions[] order (sorted by key)
+static uint32_t* data = NULL;
+static size_t* order = NULL;            // Solve order: deepest positions first
+static atomic_size_t next_pos;
+static atomic_size_t done_count;
+static atomic_int exact_count;
+static tt_t* tt = NULL;
+static int search_ms = 0;               // 0 - exact solver, else the --search fallback
+static int search_threads = 1;
+
+static uint32_t pack_entry(int score, int col, int depth, int exact) {   // { score - search scale, col - canonical orientation }
+    // data bits: 0..15 score + 32768 | 16..23 column | 24..30 depth | 31 exact
+    return (uint32_t)(uint16_t)(score + 32768)
+        | ((uint32_t)col << 16)
+        | ((uint32_t)(depth & 0x7F) << 24)
+        | ((exact) ? ((uint32_t)BOOK_EXACT << 24) : 0u);
+}
+
+static int search_scale(const board_t* b, int score) {   // { score - exact solver score of b }
+    // The solver's score in the search's scale: SEARCH_WIN minus the plies until the win
+    int plies = solve_plies_to_end(b, score);
+
+    if (score > 0) return SEARCH_WIN - plies;
+    if (score < 0) return -(SEARCH_WIN - plies);
+    return 0;
+}
+
+static void report(void) {
+    // Progress line, every 10 positions and at the end
+    size_t n = atomic_fetch_add(&done_count, 1) + 1;
+
+    if (n % 10 == 0 || n == pos_count) {
+        printf("\r%zu / %zu done, %d exact", n, pos_count, atomic_load(&exact_count));
+        fflush(stdout);
+    }
+}
+
+// ------ Exact ----
+static int solve_worker(void* arg) {
+    // Solves positions in order[] until none is left
+    (void)arg;
+
+    for (;;) {
+        size_t k = atomic_fetch_add(&next_pos, 1);
+        const gen_pos_t* p;
+        solve_result_t res;
+
+        if (k >= pos_count) break;
+        p = &positions[order[k]];
+
+        solve_best_move(&p->board, tt, &res);
+        data[order[k]] = pack_entry(search_scale(&p->board, res.score), board_mirror_col(res.best_col, p->mirrored),
+                                    BOARD_CELLS - p->board.moves, 1);
+        atomic_fetch_add(&exact_count, 1);
+        report();
+    }
+    return 0;
+}
+
+// ------ Fallback: timed search ----
+static void search_all(void) {
+    // One position at a time, all threads in its Lazy SMP search
+    for (size_t k = 0; k < pos_count; k++) {
+        const gen_pos_t* p = &positions[order[k]];
+        search_params_t params = { SEARCH_MAX_DEPTH, search_ms, search_threads, NULL, 0 };
+        search_result_t res;
+        int col = search_best_move(&p->board, &params, tt, &res);
+        int proven = (res.score >= SEARCH_WIN_MIN || res.score <= -SEARCH_WIN_MIN
+            || res.depth == BOARD_CELLS - p->board.moves);
+
+        data[order[k]] = pack_entry(res.score, board_mirror_col(col, p->mirrored), res.depth, proven);
+        if (proven) atomic_fetch_add(&exact_count, 1);
+        report();
+    }
+}
+
+static int cmp_deeper(const void* a, const void* b) {
+    // Deepest ply first, then key order
+    const gen_pos_t* pa = &positions[*(const size_t*)a];
+    const gen_pos_t* pb = &positions[*(const size_t*)b];
+
+    if (pa->board.moves != pb->board.moves) return pb->board.moves - pa->board.moves;
+    return (pa->key > pb->key) - (pa->key < pb->key);
+}
+
+/*=======*/
+
+
+// ===== Main function ======
+
+int main(int argc, char** argv) {
+    const char* path = BOOK_DEFAULT_PATH;
+    int max_ply = 4;
+    int threads = search_cpu_count();
+    int hash_mb = 1024;
+    int positional = 0;
+    int bad = 0;
+    board_t root;
+    thrd_t* handles;
+    int started = 0;
+    double start = time_now_ms();
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--search") && i + 1 < argc) {
+            search_ms = atoi(argv[++i]);
+            bad |= (search_ms < 1);
+        }
+        else if (positional == 0) { path = argv[i]; positional++; }
+        else if (positional == 1) { max_ply = atoi(argv[i]); positional++; }
+        else if (positional == 2) { threads = atoi(argv[i]); positional++; }
+        else if (positional == 3) { hash_mb = atoi(argv[i]); positional++; }
+        else bad = 1;
+    }
+    if (threads < 1) threads = 1;
+    search_threads = threads;
+
+    if (bad || max_ply < 0 || max_ply >= BOARD_CELLS) {
+        printf("usage: %s [out_file] [max_ply] [threads] [hash_mb] [--search <ms>]\n", argv[0]);
+        return 1;
+    }
+
+    // ------ Collect positions ----
+    board_reset(&root);
+    if (!enumerate(&root, max_ply)) {
+        printf("Out of memory while enumerating positions.\n");
+        return 1;
+    }
+    printf("%zu positions up to ply %d", pos_count, max_ply);
+    sort_unique();
+    printf(", %zu after folding mirror images\n", pos_count);
+
+    keys = (uint64_t*)malloc(pos_count * sizeof(*keys));
+    data = (uint32_t*)malloc(pos_count * sizeof(*data));
+    order = (size_t*)malloc(pos_count * sizeof(*order));
+    handles = (thrd_t*)calloc((size_t)threads, sizeof(*handles));
+    tt = tt_create((size_t)hash_mb, 1);
+    if (!keys || !data || !order || !handles || !tt) {
+        printf("Out of memory.\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < pos_count; i++) {
+        keys[i] = positions[i].key;
+        order[i] = i;
+    }
+    qsort(order, pos_count, sizeof(*order), cmp_deeper);
+
+    atomic_init(&next_pos, 0);
+    atomic_init(&done_count, 0);
+    atomic_init(&exact_count, 0);
+
+    // ------ Solve (or search) every position ----
+    if (search_ms) {
+        printf("Fallback: %d ms searches, only proven results are exact\n", search_ms);
+        search_all();
+    }
+    else {
+        printf("Solving on %d threads, %d MB shared table\n", threads, hash_mb);
+        for (int i = 0; i < threads; i++) {
+            if (thrd_create(&handles[i], solve_worker, NULL) != thrd_success) break;
+            started++;
+        }
+        if (!started) solve_worker(NULL);
+        for (int i = 0; i < started; i++) thrd_join(handles[i], NULL);
+    }
+    printf("\n");
+
+    // ------ Write the book ----
+    {
+        book_header_t hdr = { BOOK_MAGIC, BOOK_VERSION, ROWS, COLS, (uint32_t)max_ply, (uint32_t)pos_count, { 0, 0 } };
+        FILE* f = fopen(path, "wb");
+
+        if (!f
+            || fwrite(&hdr, sizeof(hdr), 1, f) != 1
+            || fwrite(keys, sizeof(*keys), pos_count, f) != pos_count
+            || fwrite(data, sizeof(*data), pos_count, f) != pos_count) {
+            printf("Could not write %s\n", path);
+            if (f) fclose(f);
+            return 1;
+        }
+        fclose(f);
+    }
+
+    printf("Wrote %s: %zu entries (%d exact), %zu bytes, %.1f s\n", path, pos_count, atomic_load(&exact_count),
+        sizeof(book_header_t) + pos_count * (sizeof(uint64_t) + sizeof(uint32_t)),
+        (time_now_ms() - start) / 1000.0);
+
+    tt_destroy(tt);
+    free(handles);
+    free(order);
+    free(keys);
+    free(data);
+    free(positions);
+    return 0;
+}
+
+/*=======*/
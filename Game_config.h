@@ -2,21 +2,71 @@
 #define GAME_CONFIG_H
 
 
+// ===== Frame rendering ======
+
+#define UI_FRAME_BYTES 16384             // Preallocated frame buffer (a full game screen is ~3 KB)
+#define UI_SCREEN_ROWS 40                // Shadow screen size; drawing outside it is clipped
+#define UI_SCREEN_COLS 120
+
+typedef struct {
+    unsigned long frames;                // Frames emitted
+    unsigned long writes;                // write() syscalls in total
+    unsigned long long bytes;            // Bytes written in total
+    unsigned long last_bytes;            // Size of the newest frame
+    unsigned long last_writes;           // Syscalls of the newest frame (1 unless it overflowed the buffer)
+    unsigned long long cells;            // Screen cells repainted by the diff renderer
+    unsigned long input_frames;          // Frames that answered a key
+    double input_ms_total;               // Keypress-to-frame latency, summed over input_frames
+    double input_ms_max;                 // Worst keypress-to-frame latency
+} ui_frame_stats_t;
+
+// ------ Animation timer ----
+typedef struct {
+    double next;                         // Monotonic time of the next tick (ms)
+    int period_ms;                       // Frame period
+} ui_timer_t;
+
+/*=======*/
+
+
 // ===== Function declarations ======
 
 // ------ Keyboard input ----
-int read_key(void);   // Read a key from the keyboard and return K_* code
+int read_key(void);       // Next key from the input thread as a K_* code (flushes the frame if it has to wait)
+int read_key_raw(int timeout_ms);   // { timeout_ms - < 0 forever } Keyboard read as a K_* code (input thread only)
+
+// ------ Frame output ----
+void ui_printf(const char* fmt, ...);    // Append formatted text to the current frame
+void ui_flush(void);                     // Send what changed since the last frame with a single write
+void ui_set_diff(int on);                // { on - 1 diff against the shadow screen (default), 0 send everything }
+int  ui_getch(void);                     // Flush the frame, then wait for a key (K_* code)
+void ui_mark_input(double t_ms);         // { t_ms - key arrival time } The next frame closes its latency sample
+void ui_frame_stats(ui_frame_stats_t* out); // { out - bytes / syscalls / frames since startup }
 
 // ------ UI functions ----
-void delay_ms(int ms);                    // { ms - delay time in milliseconds }
+void delay_ms(int ms);                    // { ms - delay time in milliseconds } Sleeps, no busy-wait
+void ui_timer_start(ui_timer_t* t, int period_ms); // { t - timer, period_ms - frame period }
+int  ui_timer_wait(ui_timer_t* t);       // Flush the frame, then sleep until the next tick. 1 - cut short by a key
 void clear_screen(void);                 // Clear screen + move cursor to home
+void cursor_goto(int row, int col);      // { row, col - 1-based screen position }
+void clear_line(void);                   // Clear the line under the cursor
 void ui_menu_init(void);                 // Print the static menu frame + logo
 void ui_display_manual(void);            // Print "How to play" screen and wait for key
 void ui_menu_draw_options(int selected); // { selected - current selected menu option }
 void ui_menu_flash_selected(int selected); // { selected - option to blink }
 
 // ------ Game functions ----
-int start_game(int mode);                // { mode - 0 PvP, 1 AI EZ, 2 AI HARD }
+int start_game(int mode);                // { mode - MODE_* game mode }
+int game_set_board(int cols, int rows);  // { cols/rows - board size } 0 if no geometry kernel was built for it
+
+// ------ AI setup ----
+int  ai_init(int tt_mb, int huge_pages); // { tt_mb - transposition table MB, huge_pages - 1 try large pages } 0 on failure
+void ai_set_move_time(int ms);           // { ms - per-move think time of the search AI }
+void ai_set_threads(int threads);        // { threads - search workers, 0 - one per logical CPU }
+void ai_set_ponder(int on);              // { on - 1 EXPERT searches during the human's turn }
+int  ai_open_book(const char* path);     // { path - opening book file } 0 if missing or invalid
+int  ai_open_egdb(const char* path);     // { path - endgame database file } 0 if missing or invalid
+void ai_shutdown(void);                  // Free AI memory
 
 /*=======*/
 
@@ -24,7 +74,30 @@ int start_game(int mode);                // { mode - 0 PvP, 1 AI EZ, 2 AI HARD }
 // ===== Menu constants ======
 
 // ------ Menu options count ----
-#define MENU_OPTIONS 6
+#define MENU_OPTIONS 8
+
+/*=======*/
+
+
+// ===== AI defaults ======
+
+#define AI_HASH_MB_DEFAULT  64           // --hash <MB> overrides it (1..4096)
+#define AI_TIME_MS_DEFAULT  1000         // --time <ms> overrides it
+#define AI_THREADS_DEFAULT  0            // --threads <n> overrides it (0 - one per logical CPU)
+#define AI_BOOK_DEFAULT     "connect4.book" // --book <path> overrides it (built by Game_book_gen)
+#define AI_EGDB_DEFAULT     "connect4.egdb" // --egdb <path> overrides it (built by Game_egdb_gen)
+                                         // --board <cols>x<rows> plays another size on its Game_geometry kernel
+
+/*=======*/
+
+
+// ===== Game modes ======
+
+#define MODE_PVP        0
+#define MODE_AI_EASY    1
+#define MODE_AI_HARD    2
+#define MODE_AI_EXPERT  3    // Negamax alpha-beta search
+#define MODE_AI_MCTS    4    // Monte Carlo tree search
 
 /*=======*/
 
@@ -39,6 +112,8 @@ int start_game(int mode);                // { mode - 0 PvP, 1 AI EZ, 2 AI HARD }
 #define K_ENTER   4
 #define K_ESC     5
 #define K_RESET   6
+#define K_UNDO    7
+#define K_REDO    8
 
 /*=======*/
 
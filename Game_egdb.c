@@ -0,0 +1,194 @@
+#ifndef _WIN32
+#define _DEFAULT_SOURCE     // madvise under strict -std=c11
+#endif
+
+#include <stdlib.h>
+#include "Game_egdb.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+// ===== Database state ======
+
+struct egdb_s {
+    const void* map;            // Whole file, read-only mapping
+    size_t size;                // Mapped bytes
+    const egdb_header_t* hdr;   // Header at offset 0
+    const uint64_t* slots;      // Open-addressing table right after the header
+    uint64_t mask;              // Slot count - 1
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+/*=======*/
+
+
+// ===== Memory mapping ======
+
+// ------ Open ----
+egdb_t* egdb_open(const char* path) {   // { path - database file }
+    // Maps the file read-only; pages are only read when a probe touches them
+    egdb_t* db = (egdb_t*)calloc(1, sizeof(*db));
+    if (!db) return NULL;
+
+#ifdef _WIN32
+    LARGE_INTEGER size;
+
+    db->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+    if (db->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(db->file, &size)) {
+        if (db->file != INVALID_HANDLE_VALUE) CloseHandle(db->file);
+        free(db);
+        return NULL;
+    }
+
+    db->size = (size_t)size.QuadPart;
+    db->mapping = (db->size) ? CreateFileMappingA(db->file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    db->map = (db->mapping) ? MapViewOfFile(db->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+    if (!db->map) {
+        if (db->mapping) CloseHandle(db->mapping);
+        CloseHandle(db->file);
+        free(db);
+        return NULL;
+    }
+#else
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size <= 0) {
+        if (fd >= 0) close(fd);
+        free(db);
+        return NULL;
+    }
+
+    db->size = (size_t)st.st_size;
+    db->map = mmap(NULL, db->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   /* The mapping keeps the file alive */
+
+    if (db->map == MAP_FAILED) {
+        free(db);
+        return NULL;
+    }
+#ifdef MADV_RANDOM
+    madvise((void*)db->map, db->size, MADV_RANDOM);   /* Hashed probes: no read-ahead */
+#endif
+#endif
+
+    db->hdr = (const egdb_header_t*)db->map;
+    db->slots = (const uint64_t*)(db->hdr + 1);
+
+    /* Reject foreign files, other geometries, truncated tables and tables with no empty slot */
+    if (db->size < sizeof(egdb_header_t)
+        || db->hdr->magic != EGDB_MAGIC
+        || db->hdr->version != EGDB_VERSION
+        || db->hdr->rows != ROWS
+        || db->hdr->cols != COLS
+        || db->hdr->slot_bits < 1 || db->hdr->slot_bits > 40
+        || db->size < sizeof(egdb_header_t) + ((size_t)1 << db->hdr->slot_bits) * sizeof(uint64_t)
+        || db->hdr->count >= ((uint64_t)1 << db->hdr->slot_bits)) {
+        egdb_close(db);
+        return NULL;
+    }
+
+    db->mask = ((uint64_t)1 << db->hdr->slot_bits) - 1;
+    return db;
+}
+
+// ------ Close ----
+void egdb_close(egdb_t* db) {
+    // Unmaps the file and frees the handle
+    if (!db) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(db->map);
+    CloseHandle(db->mapping);
+    CloseHandle(db->file);
+#else
+    munmap((void*)db->map, db->size);
+#endif
+    free(db);
+}
+
+/*=======*/
+
+
+// ===== Lookup ======
+
+// ------ One position ----
+int egdb_probe(const egdb_t* db, const board_t* b, int* score) {   // { db - database (can be NULL), b - position, score - out }
+    // Walks from the home slot of b's canonical key to the key or the first empty slot.
+    // At most every slot once: a corrupt file with no empty slot must not hang the AI.
+    int mirrored;
+    uint64_t key, i, n;
+
+    if (!db || BOARD_CELLS - b->moves > (int)db->hdr->max_empty) return 0;
+
+    key = board_canonical_key(b, &mirrored);
+
+    for (i = egdb_home(key, (int)db->hdr->slot_bits), n = 0; n <= db->mask && db->slots[i]; i = (i + 1) & db->mask, n++) {
+        if ((db->slots[i] >> 8) == key) {
+            *score = (int8_t)(db->slots[i] & 0xFF);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ------ Perfect move ----
+int egdb_best_move(const egdb_t* db, const board_t* b, int* score) {   // { db - database (can be NULL), b - position, score - out (can be NULL) }
+    // Plays an immediate win, else the reply whose stored value is best for us (center-first on ties).
+    // Returns -1 when b is out of range or one of its replies is missing, so the caller searches instead.
+    int player = board_player_to_move(b);
+    int best = -BOARD_CELLS, best_col = -1;
+    board_t child;
+
+    if (!db || board_is_full(b) || BOARD_CELLS - b->moves > (int)db->hdr->max_empty) return -1;
+
+    if (board_winning_moves(b, player)) {
+        if (score) *score = (BOARD_CELLS + 1 - b->moves) / 2;
+        return board_move_column(board_winning_moves(b, player));
+    }
+
+    child = *b;
+    for (int i = 0; i < COLS; i++) {
+        int c = COLS / 2 + ((i % 2) ? (i + 1) / 2 : -(i + 1) / 2);
+        int v;
+
+        if (!board_can_play(b, c)) continue;
+
+        board_drop(&child, c, player);
+        if (board_is_full(&child)) v = 0;
+        else if (egdb_probe(db, &child, &v)) v = -v;
+        else v = -BOARD_CELLS - 1;
+        board_undo(&child, c);
+
+        if (v < -BOARD_CELLS) return -1;
+        if (v > best) {
+            best = v;
+            best_col = c;
+        }
+    }
+
+    if (score) *score = best;
+    return best_col;
+}
+
+// ------ Info ----
+int egdb_max_empty(const egdb_t* db) {
+    return (db) ? ((int)db->hdr->max_empty) : (0);
+}
+
+uint32_t egdb_count(const egdb_t* db) {
+    return (db) ? (db->hdr->count) : (0);
+}
+
+/*=======*/
@@ -0,0 +1,80 @@
+#ifndef GAME_EGDB_H
+#define GAME_EGDB_H
+
+#include <stdint.h>
+#include "Game_board.h"
+
+
+// ===== Endgame database file format ======
+//
+//   egdb_header_t                      32 bytes
+//   uint64_t slots[1 << slot_bits]     open-addressing table
+//
+// Every slot holds canonical key << 8 | (uint8_t)score, 0 - empty. The score
+// is the exact Game_solve.h score for the side to move; mirror images share
+// one slot. A key's home slot comes from its hash. A probe reads forward
+// from there until it meets the key or an empty slot. The generator keeps
+// the table at most half full, so a probe reads about 1.5 slots, almost
+// always inside one cache line: O(1), no binary search.
+//
+// Only positions with at most max_empty empty cells are stored, and only
+// those reachable from the generator's root positions: on 7x6 even the last
+// two plies of every possible game are about 3e10 positions.
+
+#define EGDB_MAGIC          0x42444534u    // "4EDB"
+#define EGDB_VERSION        1
+#define EGDB_DEFAULT_PATH   "connect4.egdb"
+
+#define EGDB_KEY_BITS       (64 - 8)       // Key room left next to the score byte
+
+#if COLS * BOARD_H1 > EGDB_KEY_BITS
+#error "Board keys do not fit next to the score byte of an endgame database slot"
+#endif
+
+typedef struct {
+    uint32_t magic;         // EGDB_MAGIC
+    uint32_t version;       // EGDB_VERSION
+    uint32_t rows;          // Board geometry the database was built for
+    uint32_t cols;
+    uint32_t max_empty;     // Positions with at most this many empty cells
+    uint32_t slot_bits;     // log2 of the slot count
+    uint32_t count;         // Positions stored
+    uint32_t reserved;
+} egdb_header_t;
+
+typedef struct egdb_s egdb_t;
+
+/*=======*/
+
+
+// ===== Slot helpers (shared with the generator) ======
+
+static inline uint64_t egdb_slot(uint64_t key, int score) {   // { key - canonical key, score - exact score }
+    // Packs one stored position
+    return (key << 8) | (uint8_t)(int8_t)score;
+}
+
+static inline uint64_t egdb_home(uint64_t key, int slot_bits) {   // { slot_bits - log2 of the slot count }
+    // Home slot of key (Fibonacci hashing, like the transposition table)
+    return (key * 0x9E3779B97F4A7C15ULL) >> (64 - slot_bits);
+}
+
+/*=======*/
+
+
+// ===== Endgame database functions ======
+
+// ------ Lifetime ----
+egdb_t* egdb_open(const char* path);                  // Memory-maps a database file. NULL if missing or invalid.
+void    egdb_close(egdb_t* db);                       // Unmaps the file (NULL is ignored)
+
+// ------ Lookup ----
+int egdb_probe(const egdb_t* db, const board_t* b, int* score);       // { score - out } 1 if b is stored
+int egdb_best_move(const egdb_t* db, const board_t* b, int* score);   // { score - out (can be NULL) } Perfect move, -1 if b or a reply is not covered
+int egdb_max_empty(const egdb_t* db);                 // Empty cells covered (0 for NULL)
+uint32_t egdb_count(const egdb_t* db);                // Positions stored
+
+/*=======*/
+
+
+#endif /* GAME_EGDB_H */
@@ -0,0 +1,507 @@
+/*
+    Game_egdb_gen.c - Endgame database generator (offline)
+    ------------------------------------------------------
+    Collects every position with at most max_empty empty cells that can be
+    reached from a set of root positions, solves them backwards one level of
+    empty cells at a time and writes the hashed table Game_egdb.c maps.
+
+    Usage:
+      egdb_gen [out_file] [max_empty] [roots] [threads] [slot_bits]
+      (defaults: connect4.egdb 8 selfplay:200 <all CPUs> 24)
+
+    roots is either a file of move strings ("4453...", one per line) or
+    selfplay:<games>: hard vs hard games with random moves mixed in, each
+    cut at the first position with max_empty + EGDB_ROOT_SPREAD empty cells.
+    Every reachable position is out of reach on 7x6 (about 3e10 with two
+    empty cells or fewer), so the database covers the endgames of those games.
+
+    Scores are exact and follow Game_solve.h, so they also give the distance
+    to the end of the game. Positions where the side to move wins at once are
+    stored without their replies. slot_bits sizes the in-memory position set
+    (9 bytes per slot, at most 3/4 full).
+
+    Build (MinGW / gcc):
+      gcc -O2 Game_egdb_gen.c Game_egdb.c Game_ai.c Game_board.c Game_book.c Game_eval.c Game_mcts.c Game_pns.c Game_search.c Game_tt.c Game_time.c -o egdb_gen -pthread -lm
+*/
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include "Game_ai.h"
+#include "Game_board.h"
+#include "Game_egdb.h"
+#include "Game_rng.h"
+#include "Game_time.h"
+
+
+// ===== Configuration ======
+
+#define EGDB_ROOT_SPREAD    2       // Roots sit this many plies before database range
+#define EGDB_RANDOM_PLIES   4       // Random opening plies of a self-play root game
+#define EGDB_RANDOM_ODDS    4       // Later, one move in this many is random too
+#define EGDB_ROOT_TRIES     20      // Self-play attempts per requested root
+
+static int max_empty = 8;
+static int threads = 1;
+static int slot_bits = 24;
+
+/*=======*/
+
+
+// ===== Position set ======
+//
+// Open addressing over canonical keys, filled by every worker at once with
+// compare-and-swap (0 - empty slot). value[] is written later, level by level.
+
+static _Atomic uint64_t* set_keys = NULL;
+static int8_t* set_value = NULL;
+static uint64_t set_mask = 0;
+static atomic_size_t set_count;
+static atomic_int set_full;
+
+static int set_insert(uint64_t key) {   // { key - canonical key (never 0) }
+    // Returns 1 if key was added, 0 if it was already there, -1 if the set is full
+    uint64_t i = egdb_home(key, slot_bits);
+
+    for (uint64_t n = 0; n <= set_mask; n++, i = (i + 1) & set_mask) {
+        uint64_t cur = atomic_load_explicit(&set_keys[i], memory_order_relaxed);
+
+        if (cur == key) return 0;
+        if (cur) continue;
+
+        if (atomic_compare_exchange_strong(&set_keys[i], &cur, key)) {
+            if (atomic_fetch_add(&set_count, 1) + 1 > (set_mask + 1) / 4 * 3) atomic_store(&set_full, 1);
+            return 1;
+        }
+        if (cur == key) return 0;   /* Another worker stored the same key first */
+    }
+
+    atomic_store(&set_full, 1);
+    return -1;
+}
+
+static int64_t set_find(uint64_t key) {   // { key - canonical key }
+    // Slot of key, or -1 (only called once every insert is done)
+    uint64_t i = egdb_home(key, slot_bits);
+    uint64_t cur;
+
+    while ((cur = atomic_load_explicit(&set_keys[i], memory_order_relaxed)) != 0) {
+        if (cur == key) return (int64_t)i;
+        i = (i + 1) & set_mask;
+    }
+    return -1;
+}
+
+/*=======*/
+
+
+// ===== Roots ======
+
+static board_t* roots = NULL;
+static int root_count = 0;
+static int root_cap = 0;
+
+static int push_root(const board_t* b) {   // { b - root position }
+    // Appends one root. Returns 0 when out of memory.
+    if (root_count == root_cap) {
+        int cap = (root_cap) ? (root_cap * 2) : (256);
+        board_t* r = (board_t*)realloc(roots, (size_t)cap * sizeof(*r));
+        if (!r) return 0;
+        roots = r;
+        root_cap = cap;
+    }
+    roots[root_count++] = *b;
+    return 1;
+}
+
+// ------ Self-play ----
+static unsigned move_columns(bitboard_t moves) {   // { moves - landing cells }
+    // Column mask of a landing-cell mask
+    unsigned m = 0;
+    for (int c = 0; c < COLS; c++) m |= (unsigned)((moves & bitboard_column(c)) != 0) << c;
+    return m;
+}
+
+static int selfplay_root(rng_t* rng, board_t* b) {   // { rng - game generator, b - out }
+    // Plays one game up to database range + EGDB_ROOT_SPREAD. Returns 0 if it ended earlier.
+    board_reset(b);
+
+    while (BOARD_CELLS - b->moves > max_empty + EGDB_ROOT_SPREAD) {
+        int player = board_player_to_move(b);
+        int col;
+
+        if (b->moves < EGDB_RANDOM_PLIES || rng_below(rng, EGDB_RANDOM_ODDS) == 0) {
+            /* Random, but neither winning nor losing at once: the game must go on */
+            col = rng_pick(rng, move_columns(board_safe_moves(b) & ~board_winning_moves(b, player)));
+        }
+        else {
+            col = ai_choose_column_hard(b, player, NULL);
+        }
+        if (col < 0) return 0;
+
+        board_drop(b, col, player);
+        if (board_has_won(b, player) || board_is_full(b)) return 0;
+    }
+    return 1;
+}
+
+static int selfplay_roots(int games) {   // { games - roots wanted }
+    // Collects up to `games` roots from seeded games (the same roots on every run)
+    rng_t rng;
+    board_t b;
+
+    rng_seed(&rng, 1);
+    for (int tries = 0; root_count < games && tries < games * EGDB_ROOT_TRIES; tries++) {
+        if (selfplay_root(&rng, &b) && !push_root(&b)) return 0;
+    }
+    return 1;
+}
+
+// ------ Roots file ----
+static int file_roots(const char* path) {   // { path - one move string per line }
+    // Reads roots from a file. Lines that are illegal or end the game are skipped.
+    char line[256];
+    FILE* f = fopen(path, "r");
+    board_t b;
+
+    if (!f) return 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, " \t\r\n")] = '\0';
+        if (!board_from_moves(&b, line) || board_is_full(&b)) continue;
+
+        if (BOARD_CELLS - b.moves > max_empty + EGDB_ROOT_SPREAD) {
+            fprintf(stderr, "skipping root %s: more than %d empty cells\n", line, max_empty + EGDB_ROOT_SPREAD);
+            continue;
+        }
+        if (!push_root(&b)) break;
+    }
+
+    fclose(f);
+    return 1;
+}
+
+/*=======*/
+
+
+// ===== Enumeration ======
+
+static atomic_int next_root;
+
+static void expand(board_t* b) {   // { b - non-terminal position, restored on return }
+    // Adds b (if in range) and everything reachable below it. Stops at known positions
+    // and at positions the side to move wins at once: their score needs no replies.
+    int player = board_player_to_move(b);
+
+    if (atomic_load_explicit(&set_full, memory_order_relaxed)) return;
+
+    if (BOARD_CELLS - b->moves <= max_empty) {
+        int mirrored;
+        if (set_insert(board_canonical_key(b, &mirrored)) <= 0) return;
+    }
+    if (board_winning_moves(b, player)) return;
+
+    for (int c = 0; c < COLS; c++) {
+        if (!board_can_play(b, c)) continue;
+
+        board_drop(b, c, player);
+        if (!board_is_full(b)) expand(b);   /* No reply wins: b had no winning move */
+        board_undo(b, c);
+    }
+}
+
+static int enumerate_worker(void* arg) {
+    // Pulls roots until every root has been expanded
+    (void)arg;
+
+    for (;;) {
+        int i = atomic_fetch_add(&next_root, 1);
+        board_t b;
+
+        if (i >= root_count) break;
+        b = roots[i];
+        expand(&b);
+    }
+    return 0;
+}
+
+/*=======*/
+
+
+// ===== Retrograde solve ======
+//
+// Moves only fill cells, so every reply has one empty cell less. Solving the
+// levels from 1 empty cell upward means every reply is already solved.
+
+typedef struct {
+    uint32_t* slots;        // Set slots of the level's positions
+    size_t count;
+    int id;                 // Worker index
+    size_t missing;         // Out: positions whose replies were not in the set
+    size_t wins, draws, losses;   // Out: results for the side to move
+} level_job_t;
+
+static int solve_position(uint64_t key, int* score) {   // { key - canonical key, score - out }
+    // Exact score from the replies' stored scores. Returns 0 if a reply is missing.
+    board_t b;
+    int player, best = -BOARD_CELLS;
+
+    board_from_key(&b, key);
+    player = board_player_to_move(&b);
+
+    if (board_winning_moves(&b, player)) {
+        *score = (BOARD_CELLS + 1 - b.moves) / 2;
+        return 1;
+    }
+
+    for (int c = 0; c < COLS; c++) {
+        int mirrored, v;
+        int64_t slot;
+
+        if (!board_can_play(&b, c)) continue;
+
+        board_drop(&b, c, player);
+        if (board_is_full(&b)) {
+            v = 0;
+        }
+        else {
+            slot = set_find(board_canonical_key(&b, &mirrored));
+            if (slot < 0) return 0;
+            v = -set_value[slot];
+        }
+        board_undo(&b, c);
+
+        if (v > best) best = v;
+    }
+
+    *score = best;
+    return 1;
+}
+
+static int level_worker(void* arg) {   // { arg - level_job_t }
+    // Solves every threads-th position of one level
+    level_job_t* job = (level_job_t*)arg;
+
+    for (size_t i = (size_t)job->id; i < job->count; i += (size_t)threads) {
+        uint32_t slot = job->slots[i];
+        int score;
+
+        if (!solve_position(atomic_load_explicit(&set_keys[slot], memory_order_relaxed), &score)) {
+            job->missing++;
+            score = 0;
+        }
+        set_value[slot] = (int8_t)score;
+
+        if (score > 0)      job->wins++;
+        else if (score < 0) job->losses++;
+        else                job->draws++;
+    }
+    return 0;
+}
+
+/*=======*/
+
+
+// ===== Output ======
+
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t ka = *(const uint64_t*)a;
+    uint64_t kb = *(const uint64_t*)b;
+    return (ka > kb) - (ka < kb);
+}
+
+static int write_db(const char* path, size_t count) {   // { path - output file, count - positions in the set }
+    // Rehashes the set into a table at most half full and writes it after the header.
+    // Entries go in in key order, so the file does not depend on the thread count.
+    egdb_header_t hdr = { EGDB_MAGIC, EGDB_VERSION, ROWS, COLS, 0, 1, 0, 0 };
+    uint64_t* table;
+    uint64_t* sorted;
+    uint64_t mask;
+    size_t slots, n = 0;
+    FILE* f;
+    int ok;
+
+    while (((size_t)1 << hdr.slot_bits) < 2 * count) hdr.slot_bits++;
+    slots = (size_t)1 << hdr.slot_bits;
+    mask = slots - 1;
+    hdr.max_empty = (uint32_t)max_empty;
+    hdr.count = (uint32_t)count;
+
+    table = (uint64_t*)calloc(slots, sizeof(*table));
+    sorted = (uint64_t*)malloc((count ? count : 1) * sizeof(*sorted));
+    if (!table || !sorted) {
+        free(table);
+        free(sorted);
+        return 0;
+    }
+
+    for (uint64_t i = 0; i <= set_mask && n < count; i++) {
+        uint64_t key = atomic_load_explicit(&set_keys[i], memory_order_relaxed);
+        if (key) sorted[n++] = egdb_slot(key, set_value[i]);
+    }
+    qsort(sorted, n, sizeof(*sorted), cmp_u64);   /* Slots sort by key: the score is the low byte */
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t j;
+        for (j = egdb_home(sorted[i] >> 8, (int)hdr.slot_bits); table[j]; j = (j + 1) & mask) {}
+        table[j] = sorted[i];
+    }
+    free(sorted);
+
+    f = fopen(path, "wb");
+    ok = f && fwrite(&hdr, sizeof(hdr), 1, f) == 1 && fwrite(table, sizeof(*table), slots, f) == slots;
+    if (f && fclose(f) != 0) ok = 0;
+
+    free(table);
+    if (ok) printf("wrote %s: %zu positions, %zu slots, %.1f MB\n", path, count, slots,
+                   (double)(sizeof(hdr) + slots * sizeof(*table)) / (1024.0 * 1024.0));
+    return ok;
+}
+
+/*=======*/
+
+
+// ===== Main function ======
+
+static void run_workers(thrd_start_t fn, void* args, size_t arg_size) {   // { args - threads arguments of arg_size bytes }
+    // Runs fn on every worker argument and waits for all of them (inline if no thread starts)
+    thrd_t* handles = (thrd_t*)calloc((size_t)threads, sizeof(*handles));
+    int started = 0;
+
+    for (int i = 0; handles && i < threads; i++) {
+        if (thrd_create(&handles[i], fn, (char*)args + (size_t)i * arg_size) != thrd_success) break;
+        started++;
+    }
+    if (!started) {
+        for (int i = 0; i < threads; i++) fn((char*)args + (size_t)i * arg_size);
+    }
+    for (int i = 0; i < started; i++) thrd_join(handles[i], NULL);
+    free(handles);
+}
+
+int main(int argc, char** argv) {
+    const char* out_path = (argc > 1) ? argv[1] : EGDB_DEFAULT_PATH;
+    const char* root_spec = (argc > 3) ? argv[3] : "selfplay:200";
+    level_job_t* jobs;
+    uint32_t* level_slots;
+    size_t count, missing = 0;
+    size_t level_start[BOARD_CELLS + 2] = { 0 };
+    double start, t;
+
+    threads = search_cpu_count();
+    if (argc > 2) max_empty = atoi(argv[2]);
+    if (argc > 4) threads = atoi(argv[4]);
+    if (argc > 5) slot_bits = atoi(argv[5]);
+    if (threads < 1) threads = 1;
+
+    if (max_empty < 1 || max_empty >= BOARD_CELLS || slot_bits < 10 || slot_bits > 32) {
+        printf("usage: %s [out_file] [max_empty 1..%d] [roots_file | selfplay:<games>] [threads] [slot_bits 10..32]\n",
+               argv[0], BOARD_CELLS - 1);
+        return 1;
+    }
+
+    // ------ Roots ----
+    start = time_now_ms();
+    if (!strncmp(root_spec, "selfplay:", 9)) {
+        if (!selfplay_roots(atoi(root_spec + 9))) return 1;
+    }
+    else if (!file_roots(root_spec)) {
+        fprintf(stderr, "cannot read roots from %s\n", root_spec);
+        return 1;
+    }
+    printf("%d roots with at most %d empty cells (%.0f ms)\n", root_count, max_empty + EGDB_ROOT_SPREAD, time_now_ms() - start);
+    if (!root_count) return 1;
+
+    // ------ Enumeration ----
+    set_mask = ((uint64_t)1 << slot_bits) - 1;
+    set_keys = (_Atomic uint64_t*)calloc((size_t)set_mask + 1, sizeof(*set_keys));
+    set_value = (int8_t*)calloc((size_t)set_mask + 1, sizeof(*set_value));
+    if (!set_keys || !set_value) {
+        fprintf(stderr, "out of memory for 2^%d slots\n", slot_bits);
+        return 1;
+    }
+    atomic_init(&set_count, 0);
+    atomic_init(&set_full, 0);
+    atomic_init(&next_root, 0);
+
+    t = time_now_ms();
+    run_workers(enumerate_worker, NULL, 0);
+    count = atomic_load(&set_count);
+    if (atomic_load(&set_full)) {
+        fprintf(stderr, "position set full after %zu positions: raise slot_bits\n", count);
+        return 1;
+    }
+    t = time_now_ms() - t;
+    printf("%zu positions on %d threads (%.0f ms, %.0f positions/sec)\n", count, threads, t, (t > 0) ? (count * 1000.0 / t) : 0.0);
+
+    // ------ Levels ----
+    /* Counting sort of the set slots by empty cells */
+    level_slots = (uint32_t*)malloc((count ? count : 1) * sizeof(*level_slots));
+    jobs = (level_job_t*)calloc((size_t)threads, sizeof(*jobs));
+    if (!level_slots || !jobs) return 1;
+
+    for (uint64_t i = 0; i <= set_mask; i++) {
+        uint64_t key = atomic_load_explicit(&set_keys[i], memory_order_relaxed);
+        board_t b;
+        if (!key) continue;
+        board_from_key(&b, key);
+        level_start[BOARD_CELLS - b.moves + 1]++;
+    }
+    for (int e = 1; e <= BOARD_CELLS + 1; e++) level_start[e] += level_start[e - 1];
+    {
+        size_t fill[BOARD_CELLS + 1];
+        memcpy(fill, level_start, sizeof(fill));
+        for (uint64_t i = 0; i <= set_mask; i++) {
+            uint64_t key = atomic_load_explicit(&set_keys[i], memory_order_relaxed);
+            board_t b;
+            if (!key) continue;
+            board_from_key(&b, key);
+            level_slots[fill[BOARD_CELLS - b.moves]++] = (uint32_t)i;
+        }
+    }
+
+    // ------ Retrograde ----
+    t = time_now_ms();
+    for (int e = 1; e <= max_empty; e++) {
+        size_t wins = 0, draws = 0, losses = 0;
+
+        for (int i = 0; i < threads; i++) {
+            level_job_t job = { level_slots + level_start[e], level_start[e + 1] - level_start[e], i, 0, 0, 0, 0 };
+            jobs[i] = job;
+        }
+        run_workers(level_worker, jobs, sizeof(*jobs));
+
+        for (int i = 0; i < threads; i++) {
+            missing += jobs[i].missing;
+            wins += jobs[i].wins;
+            draws += jobs[i].draws;
+            losses += jobs[i].losses;
+        }
+        printf("  %2d empty  %10zu positions   W/D/L %zu / %zu / %zu\n", e, level_start[e + 1] - level_start[e], wins, draws, losses);
+    }
+    t = time_now_ms() - t;
+    printf("solved in %.0f ms (%.0f positions/sec)\n", t, (t > 0) ? (count * 1000.0 / t) : 0.0);
+
+    if (missing) {
+        fprintf(stderr, "%zu positions had replies outside the set\n", missing);
+        return 1;
+    }
+
+    // ------ Write ----
+    if (!write_db(out_path, count)) {
+        fprintf(stderr, "cannot write %s\n", out_path);
+        return 1;
+    }
+    printf("total %.0f ms\n", time_now_ms() - start);
+
+    free(level_slots);
+    free(jobs);
+    free(set_value);
+    free((void*)set_keys);
+    free(roots);
+    return 0;
+}
+
+/*=======*/
@@ -0,0 +1,248 @@
+#include <threads.h>
+#include "Game_eval.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+static inline int ctz64(uint64_t x) { unsigned long i; _BitScanForward64(&i, x); return (int)i; }
+#else
+#define ctz64(x)        __builtin_ctzll(x)
+#endif
+
+
+// ===== Window tables ======
+
+#define EVAL_CELL_WINDOWS   16      // Windows through one cell (4 per direction at most)
+#define EVAL_BITS           (COLS * BOARD_H1)
+
+static bitboard_t windows[EVAL_WINDOWS];                            // Every line of four cells
+static int window_count = 0;
+static uint8_t cell_windows[EVAL_BITS][EVAL_CELL_WINDOWS];         // Windows through each bit
+static uint8_t cell_window_count[EVAL_BITS];
+static once_flag tables_once = ONCE_FLAG_INIT;
+
+static void build_tables(void) {
+    // Lists every window of four cells and, for every cell, the windows through it
+    static const int dirs[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 } };   /* { dc, dh } */
+
+    for (int d = 0; d < 4; d++) {
+        for (int c = 0; c < COLS; c++) {
+            for (int h = 0; h < ROWS; h++) {
+                int ec = c + 3 * dirs[d][0];
+                int eh = h + 3 * dirs[d][1];
+                bitboard_t w = 0;
+
+                if (ec >= COLS || eh < 0 || eh >= ROWS) continue;
+
+                for (int k = 0; k < 4; k++) {
+                    int bit = (c + k * dirs[d][0]) * BOARD_H1 + h + k * dirs[d][1];
+                    w |= (bitboard_t)1 << bit;
+                    cell_windows[bit][cell_window_count[bit]++] = (uint8_t)window_count;
+                }
+                windows[window_count++] = w;
+            }
+        }
+    }
+}
+
+/*=======*/
+
+
+// ===== Scoring ======
+
+// ------ One window ----
+static inline int chips_in(bitboard_t x) {   // { x - at most 4 bits }
+    // Bit count without a library call (no popcnt instruction is assumed)
+    int n = 0;
+    for (; x; x &= x - 1) n++;
+    return n;
+}
+
+static int line_value(int count, bitboard_t empty, int odd_rows) {   // { count - chips of the owner, empty - empty cells, odd_rows - 1 Player 1 }
+    // Value of a window only one side has chips in
+    if (count == 1) return EVAL_LINE1;
+    if (count == 2) return EVAL_LINE2;
+    if (count == 3) {
+        /* Bit h of a column is row h + 1 from the bottom: Player 1 wants even h, Player 2 odd h */
+        int h = ctz64(empty) % BOARD_H1;
+        return EVAL_LINE3 + ((((h & 1) == 0) == odd_rows) ? EVAL_PARITY : 0);
+    }
+    return 0;   /* Four in a row is a game result, not an evaluation */
+}
+
+static int window_value(const board_t* b, bitboard_t w) {   // { w - window mask }
+    // Player 1's view of one window
+    bitboard_t p1 = b->chips[0] & w;
+    bitboard_t p2 = b->chips[1] & w;
+
+    if (p1 && p2) return 0;
+    if (p1) return line_value(chips_in(p1), w & ~p1, 1);
+    if (p2) return -line_value(chips_in(p2), w & ~p2, 0);
+    return 0;
+}
+
+static void rescore_cell(eval_pos_t* p, int bit, int center) {   // { bit - cell that changed, center - its center bonus change }
+    // Rescores the windows through one cell and adds the differences to the running score
+    int delta = center;
+
+    for (int i = 0; i < cell_window_count[bit]; i++) {
+        int w = cell_windows[bit][i];
+        int v = window_value(&p->b, windows[w]);
+
+        delta += v - p->value[w];
+        p->value[w] = (int16_t)v;
+    }
+    p->score += delta;
+}
+
+// ------ Full rescan ----
+int eval_full(const board_t* b) {   // { b - position }
+    // Scores the whole board from Player 1's point of view
+    int v = 0;
+
+    call_once(&tables_once, build_tables);
+
+    for (int i = 0; i < window_count; i++) v += window_value(b, windows[i]);
+    for (int h = 0; h < ROWS; h++) {
+        int bit = (COLS / 2) * BOARD_H1 + h;
+        if (b->chips[0] >> bit & 1) v += EVAL_CENTER;
+        if (b->chips[1] >> bit & 1) v -= EVAL_CENTER;
+    }
+    return v;
+}
+
+// ------ Incremental make / unmake ----
+void eval_reset(eval_pos_t* p, const board_t* b) {   // { p - tracked position, b - start position }
+    // Scores b once and remembers every window value
+    p->b = *b;
+    p->score = eval_full(b);
+    for (int i = 0; i < window_count; i++) p->value[i] = (int16_t)window_value(b, windows[i]);
+}
+
+void eval_play(eval_pos_t* p, int col) {   // { col - playable column }
+    // Only the windows through the new chip change
+    int bit = col * BOARD_H1 + p->b.height[col];
+    int player = board_player_to_move(&p->b);
+    int center = (col == COLS / 2) ? ((player == PLAYER_1) ? EVAL_CENTER : -EVAL_CENTER) : 0;
+
+    board_drop(&p->b, col, player);
+    rescore_cell(p, bit, center);
+}
+
+void eval_undo(eval_pos_t* p, int col) {   // { col - column of the last move }
+    int bit = col * BOARD_H1 + p->b.height[col] - 1;
+    int center = (col != COLS / 2) ? 0 : (p->b.chips[0] >> bit & 1) ? -EVAL_CENTER : EVAL_CENTER;
+
+    board_undo(&p->b, col);
+    rescore_cell(p, bit, center);
+}
+
+/*=======*/
+
+
+// ===== Depth-limited alpha-beta ======
+
+// ------ Move ordering ----
+static int order_moves(eval_pos_t* p, bitboard_t moves, int* cols) {   // { moves - landing cells to try, cols - out, best first }
+    // Orders the given columns by the static score after playing them (center-first on ties)
+    int keys[COLS];
+    int n = 0;
+
+    for (int i = 0; i < COLS; i++) {
+        int c = COLS / 2 + ((i % 2) ? (i + 1) / 2 : -(i + 1) / 2);
+        int key, j;
+
+        if (!(moves & bitboard_column(c))) continue;
+
+        eval_play(p, c);
+        key = -eval_side(p);
+        eval_undo(p, c);
+
+        for (j = n; j > 0 && keys[j - 1] < key; j--) {
+            keys[j] = keys[j - 1];
+            cols[j] = cols[j - 1];
+        }
+        keys[j] = key;
+        cols[j] = c;
+        n++;
+    }
+    return n;
+}
+
+// ------ Negamax ----
+static int negamax(eval_pos_t* p, int depth, int alpha, int beta, uint64_t* nodes) {   // { depth - plies left }
+    // Static score at the horizon; wins are found one ply early and losing moves dropped like Game_search.c
+    int cols[COLS];
+    int n, best = -EVAL_INF;
+    bitboard_t safe;
+
+    (*nodes)++;
+
+    if (board_winning_moves(&p->b, board_player_to_move(&p->b))) return EVAL_WIN - (p->b.moves + 1);
+    if (p->b.moves >= BOARD_CELLS - 1) return 0;
+
+    safe = board_safe_moves(&p->b);
+    if (!safe) return -(EVAL_WIN - (p->b.moves + 2));
+    if (depth == 0) return eval_side(p);
+
+    /* Our next chance to win comes after the opponent's reply */
+    if (beta > EVAL_WIN - (p->b.moves + 3)) {
+        beta = EVAL_WIN - (p->b.moves + 3);
+        if (alpha >= beta) return beta;
+    }
+
+    n = order_moves(p, safe, cols);
+
+    for (int i = 0; i < n; i++) {
+        int score;
+
+        eval_play(p, cols[i]);
+        score = -negamax(p, depth - 1, -beta, -alpha, nodes);
+        eval_undo(p, cols[i]);
+
+        if (score > best) best = score;
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) break;
+    }
+    return best;
+}
+
+// ------ Root ----
+int eval_best_move(const board_t* b, int depth, int* score, uint64_t* nodes) {   // { b - position, depth - plies, score/nodes - out (can be NULL) }
+    // Returns the column with the best depth-limited score for the side to move, or -1 if the board is full
+    eval_pos_t p;
+    int cols[COLS];
+    int n, best = -EVAL_INF, best_col = -1;
+    bitboard_t moves;
+    uint64_t count = 0;
+
+    if (board_is_full(b)) return -1;
+    if (depth < 1) depth = 1;
+
+    eval_reset(&p, b);
+    moves = board_winning_moves(b, board_player_to_move(b));
+    if (!moves) moves = board_safe_moves(b);
+    if (!moves) moves = board_playable(b);      /* Lost anyway: still pick a column */
+    n = order_moves(&p, moves, cols);
+
+    for (int i = 0; i < n; i++) {
+        int player = board_player_to_move(&p.b);
+        int s;
+
+        eval_play(&p, cols[i]);
+        if (board_has_won(&p.b, player))   s = EVAL_WIN - p.b.moves;
+        else if (board_is_full(&p.b))      s = 0;
+        else                               s = -negamax(&p, depth - 1, -EVAL_INF, -best, &count);
+        eval_undo(&p, cols[i]);
+
+        if (s > best) {
+            best = s;
+            best_col = cols[i];
+        }
+    }
+
+    if (score) *score = best;
+    if (nodes) *nodes = count;
+    return best_col;
+}
+
+/*=======*/
@@ -0,0 +1,62 @@
+#ifndef GAME_EVAL_H
+#define GAME_EVAL_H
+
+#include <stdint.h>
+#include "Game_board.h"
+
+
+// ===== Static evaluation ======
+//
+// Scores every window of four cells (row, column, both diagonals) that
+// only one side has chips in:
+//   1 / 2 / 3 chips    EVAL_LINE1 / EVAL_LINE2 / EVAL_LINE3
+//   3 chips whose empty cell sits on the owner's parity row
+//                      + EVAL_PARITY (odd rows for Player 1, even rows
+//                      for Player 2, counted 1-based from the bottom)
+// plus EVAL_CENTER per chip in the center column.
+//
+// A chip only changes the windows through its own cell (at most 16, about
+// 6 on average). eval_pos_t keeps the value of every window, so
+// eval_play / eval_undo rescore just those windows and add the
+// differences instead of rescanning the board.
+
+#define EVAL_LINE1      1
+#define EVAL_LINE2      4
+#define EVAL_LINE3      16
+#define EVAL_PARITY     12
+#define EVAL_CENTER     3
+
+#define EVAL_WIN        100000      // Win score minus the number of chips on the board after the winning move
+#define EVAL_INF        1000000
+
+#define EVAL_WINDOWS    ((COLS - 3) * ROWS + COLS * (ROWS - 3) + 2 * (COLS - 3) * (ROWS - 3))   // 69 on a 7x6 board
+
+typedef struct {
+    board_t b;              // Position
+    int score;              // Static score from Player 1's point of view
+    int16_t value[EVAL_WINDOWS];   // Current value of every window (part of score)
+} eval_pos_t;
+
+/*=======*/
+
+
+// ===== Evaluation functions ======
+
+// ------ Scoring ----
+int  eval_full(const board_t* b);                      // Rescans every window. Player 1's point of view.
+void eval_reset(eval_pos_t* p, const board_t* b);      // { b - position to track } Copies b and scores it once
+void eval_play(eval_pos_t* p, int col);                // { col - playable column } Drops a chip for the side to move (make)
+void eval_undo(eval_pos_t* p, int col);                // { col - column of the last move } Takes it back (unmake)
+
+static inline int eval_side(const eval_pos_t* p) {
+    // Static score from the side to move's point of view
+    return (p->b.moves & 1) ? (-p->score) : (p->score);
+}
+
+// ------ Depth-limited search ----
+int eval_best_move(const board_t* b, int depth, int* score, uint64_t* nodes);   // { depth - plies, score/nodes - out (can be NULL) } Column, -1 if full
+
+/*=======*/
+
+
+#endif /* GAME_EVAL_H */
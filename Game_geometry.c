@@ -0,0 +1,88 @@
+#include <stddef.h>
+#include "Game_geometry.h"
+
+
+// ===== Kernel instances ======
+//
+// One copy of Game_geometry.inc per supported geometry. Add a board size by
+// adding a block here and a row to geo_kernels[].
+
+#define GEO_COLS 7
+#define GEO_ROWS 6
+#define GEO_BB   uint64_t
+#define GEO_ID   c7r6
+#include "Game_geometry.inc"
+
+#define GEO_COLS 6
+#define GEO_ROWS 5
+#define GEO_BB   uint64_t
+#define GEO_ID   c6r5
+#include "Game_geometry.inc"
+
+#define GEO_COLS 7
+#define GEO_ROWS 7
+#define GEO_BB   uint64_t
+#define GEO_ID   c7r7
+#include "Game_geometry.inc"
+
+#define GEO_COLS 8
+#define GEO_ROWS 7
+#define GEO_BB   uint64_t
+#define GEO_ID   c8r7
+#include "Game_geometry.inc"
+
+#ifdef __SIZEOF_INT128__
+#define GEO_HAVE_WIDE
+
+#define GEO_COLS 9
+#define GEO_ROWS 7
+#define GEO_BB   unsigned __int128
+#define GEO_ID   c9r7
+#include "Game_geometry.inc"
+
+#define GEO_COLS 10
+#define GEO_ROWS 8
+#define GEO_BB   unsigned __int128
+#define GEO_ID   c10r8
+#include "Game_geometry.inc"
+#endif
+
+/*=======*/
+
+
+// ===== Dispatcher ======
+
+#define GEO_KERNEL(cols, rows, id) \
+    { #cols "x" #rows, cols, rows, cols * (rows + 1), geo_play_##id, geo_perft_##id, geo_best_move_##id }
+
+static const geo_kernel_t geo_kernels[] = {
+    GEO_KERNEL(7, 6, c7r6),
+    GEO_KERNEL(6, 5, c6r5),
+    GEO_KERNEL(7, 7, c7r7),
+    GEO_KERNEL(8, 7, c8r7),
+#ifdef GEO_HAVE_WIDE
+    GEO_KERNEL(9, 7, c9r7),
+    GEO_KERNEL(10, 8, c10r8),
+#endif
+};
+
+#define GEO_KERNELS ((int)(sizeof(geo_kernels) / sizeof(geo_kernels[0])))
+
+// ------ Lookup ----
+const geo_kernel_t* geo_kernel(int cols, int rows) {   // { cols/rows - board size }
+    // Returns the kernel compiled for cols x rows, or NULL if that size was not built
+    for (int i = 0; i < GEO_KERNELS; i++) {
+        if (geo_kernels[i].cols == cols && geo_kernels[i].rows == rows) return &geo_kernels[i];
+    }
+    return NULL;
+}
+
+const geo_kernel_t* geo_kernel_at(int i) {   // { i - kernel index }
+    return (i >= 0 && i < GEO_KERNELS) ? &geo_kernels[i] : NULL;
+}
+
+int geo_kernel_count(void) {
+    return GEO_KERNELS;
+}
+
+/*=======*/
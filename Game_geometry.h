@@ -0,0 +1,61 @@
+#ifndef GAME_GEOMETRY_H
+#define GAME_GEOMETRY_H
+
+#include <stdint.h>
+
+
+// ===== Geometry kernels ======
+//
+// Game_board.h is built for one board size (ROWS x COLS from Config.h). The
+// kernels below are the same bitboard core compiled once per geometry from
+// Game_geometry.inc, so every mask, shift and loop bound is a constant in its
+// own copy. geo_kernel() picks the copy for a board size at run time; the hot
+// loops (perft, search) run entirely inside the kernel, so the dispatch costs
+// one indirect call per request, not one per node.
+//
+// Geometries are named <cols>x<rows>, like the classic 7x6 board. A kernel
+// needs cols * (rows + 1) bits: up to 64 use uint64_t, larger boards use
+// unsigned __int128 and only exist where the compiler provides it.
+//
+// Positions are passed as move lists (0-based columns from the empty board).
+
+// ------ play() results ----
+#define GEO_ILLEGAL     -1          // A move hit a full or missing column, or the game had already ended
+#define GEO_ONGOING     0
+#define GEO_WON         1           // The last move made four in a row
+#define GEO_DRAW        2           // The last move filled the board
+
+#define GEO_SCORE_WIN   1000        // Win score minus the number of chips on the board after the winning move
+
+#define GEO_MAX_COLS    16          // Largest geometry a kernel may be built for (sizes move lists and grids)
+#define GEO_MAX_ROWS    16
+
+typedef struct {
+    uint64_t nodes;         // Positions reached at exactly `depth` plies
+    uint64_t wins;          // Games ended by four in a row within `depth` plies
+    uint64_t draws;         // Games ended on a full board within `depth` plies
+} geo_perft_t;
+
+typedef struct {
+    const char* name;       // "7x6"
+    int cols;
+    int rows;
+    int bits;               // Bitboard width in use: cols * (rows + 1)
+    int  (*play)(const uint8_t* moves, int n);                                  // GEO_* state after the moves
+    int  (*perft)(const uint8_t* moves, int n, int depth, geo_perft_t* out);    // 0 if the move list is not a running game
+    int  (*best_move)(const uint8_t* moves, int n, int depth, int* score, uint64_t* nodes);   // Column, or -1 if no move
+} geo_kernel_t;
+
+/*=======*/
+
+
+// ===== Dispatcher ======
+
+const geo_kernel_t* geo_kernel(int cols, int rows);   // Specialized kernel for the geometry, NULL if none was built
+const geo_kernel_t* geo_kernel_at(int i);             // { i - 0 .. geo_kernel_count() - 1 }
+int geo_kernel_count(void);
+
+/*=======*/
+
+
+#endif /* GAME_GEOMETRY_H */
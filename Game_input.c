@@ -0,0 +1,185 @@
+#include <stdatomic.h>
+#include <threads.h>
+#include <time.h>
+#include "Game_input.h"
+#include "Game_time.h"
+
+
+// ===== Ring state ======
+
+#define RING_MASK (INPUT_RING_SIZE - 1)
+
+static input_event_t ring[INPUT_RING_SIZE];
+static atomic_uint ring_head;          // Next slot to write (reader thread only)
+static atomic_uint ring_tail;          // Next slot to read (game thread only)
+static atomic_ulong ring_dropped;
+
+// ------ Sleeping consumer ----
+static mtx_t wake_lock;
+static cnd_t wake_cond;
+static atomic_int consumer_sleeping;   // Producer only takes the lock when this is set
+
+static int (*reader)(int) = 0;         // Key source (timeout in ms, < 0 - forever)
+static int threaded = 0;               // 1 - the reader thread is running
+static atomic_int input_closed;        // Set once read_raw reported INPUT_CLOSED
+
+/*=======*/
+
+
+// ===== Producer ======
+
+static void ring_push(int key) {   // { key - K_* code }
+    // Publishes one key; drops it when the game thread is 64 keys behind
+    unsigned h = atomic_load_explicit(&ring_head, memory_order_relaxed);
+    unsigned t = atomic_load_explicit(&ring_tail, memory_order_acquire);
+
+    if (h - t == INPUT_RING_SIZE) {
+        atomic_fetch_add_explicit(&ring_dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    ring[h & RING_MASK].key = key;
+    ring[h & RING_MASK].t_ms = time_now_ms();
+
+    /* seq_cst pairs with the consumer's flag store: either it sees the key or we see it sleeping */
+    atomic_store(&ring_head, h + 1);
+
+    if (atomic_load(&consumer_sleeping)) {
+        mtx_lock(&wake_lock);
+        cnd_signal(&wake_cond);
+        mtx_unlock(&wake_lock);
+    }
+}
+
+static int reader_main(void* arg) {
+    // Blocks on the keyboard forever, feeding the ring
+    (void)arg;
+
+    for (;;) {
+        int key = reader(-1);
+
+        if (key == INPUT_TIMEOUT) continue;
+        if (key == INPUT_CLOSED) break;
+        ring_push(key);
+    }
+
+    /* Wake the game thread so it sees the end of input */
+    atomic_store(&input_closed, 1);
+    mtx_lock(&wake_lock);
+    cnd_signal(&wake_cond);
+    mtx_unlock(&wake_lock);
+    return 0;
+}
+
+int input_start(int (*read_raw)(int timeout_ms), int use_thread) {   // { read_raw - key reader, use_thread - 1 start the reader thread }
+    // Sets the key source and starts the reader thread. Without it the waits below call read_raw themselves.
+    thrd_t th;
+
+    reader = read_raw;
+    atomic_init(&ring_head, 0);
+    atomic_init(&ring_tail, 0);
+    atomic_init(&ring_dropped, 0);
+    atomic_init(&consumer_sleeping, 0);
+    atomic_init(&input_closed, 0);
+
+    if (!use_thread) return 1;
+    if (mtx_init(&wake_lock, mtx_plain) != thrd_success) return 0;
+    if (cnd_init(&wake_cond) != thrd_success) return 0;
+    if (thrd_create(&th, reader_main, NULL) != thrd_success) return 0;
+
+    thrd_detach(th);   /* Still blocked in read_raw at exit; the process takes it down */
+    threaded = 1;
+    return 1;
+}
+
+/*=======*/
+
+
+// ===== Consumer ======
+
+int input_pending(void) {
+    return atomic_load_explicit(&ring_head, memory_order_acquire) != atomic_load_explicit(&ring_tail, memory_order_relaxed);
+}
+
+int input_poll(input_event_t* ev) {   // { ev - out }
+    // Takes the oldest queued key without blocking. Once input has ended and the ring is empty
+    // every poll returns INPUT_CLOSED, so the menus can unwind.
+    unsigned t = atomic_load_explicit(&ring_tail, memory_order_relaxed);
+    unsigned h = atomic_load_explicit(&ring_head, memory_order_acquire);
+
+    if (h == t) {
+        if (!atomic_load(&input_closed)) return 0;
+        ev->key = INPUT_CLOSED;
+        ev->t_ms = time_now_ms();
+        return 1;
+    }
+
+    *ev = ring[t & RING_MASK];
+    atomic_store_explicit(&ring_tail, t + 1, memory_order_release);
+    return 1;
+}
+
+int input_wait_pending(double deadline) {   // { deadline - time_now_ms() value, < 0 forever }
+    // Sleeps until a key is queued or the deadline passes. Returns 1 if a key is queued
+    // (after the end of input that is always true: input_poll then hands out INPUT_CLOSED).
+    if (!threaded) {
+        /* Same thread: wait inside read_raw and queue what it returns */
+        for (;;) {
+            double left = (deadline < 0) ? (-1.0) : (deadline - time_now_ms());
+            int key;
+
+            if (input_pending() || atomic_load(&input_closed)) return 1;
+            if (deadline >= 0 && left <= 0) return 0;
+
+            key = reader((deadline < 0) ? (-1) : ((int)left + 1));
+            if (key == INPUT_CLOSED) atomic_store(&input_closed, 1);
+            else if (key != INPUT_TIMEOUT) ring_push(key);
+        }
+    }
+
+    for (;;) {
+        double left;
+
+        if (input_pending() || atomic_load(&input_closed)) return 1;
+
+        left = (deadline < 0) ? (-1.0) : (deadline - time_now_ms());
+        if (deadline >= 0 && left <= 0) return 0;
+
+        mtx_lock(&wake_lock);
+        atomic_store(&consumer_sleeping, 1);
+
+        if (!input_pending() && !atomic_load(&input_closed)) {
+            if (left < 0) {
+                cnd_wait(&wake_cond, &wake_lock);
+            }
+            else {
+                /* cnd_timedwait wants wall-clock time; the loop re-checks the monotonic deadline */
+                struct timespec ts;
+                long long ns;
+
+                timespec_get(&ts, TIME_UTC);
+                ns = (long long)ts.tv_nsec + (long long)(left * 1000000.0);
+                ts.tv_sec += (time_t)(ns / 1000000000LL);
+                ts.tv_nsec = (long)(ns % 1000000000LL);
+                cnd_timedwait(&wake_cond, &wake_lock, &ts);
+            }
+        }
+
+        atomic_store(&consumer_sleeping, 0);
+        mtx_unlock(&wake_lock);
+    }
+}
+
+int input_wait(input_event_t* ev, double deadline) {   // { ev - out, deadline - time_now_ms() value, < 0 forever }
+    // Pops the next key, sleeping until one arrives or the deadline passes. Returns 1 if a key was taken.
+    while (!input_poll(ev)) {
+        if (!input_wait_pending(deadline)) return 0;
+    }
+    return 1;
+}
+
+unsigned long input_dropped(void) {
+    return atomic_load_explicit(&ring_dropped, memory_order_relaxed);
+}
+
+/*=======*/
@@ -0,0 +1,40 @@
+#ifndef GAME_INPUT_H
+#define GAME_INPUT_H
+
+
+// ===== Input queue ======
+//
+// A reader thread blocks on the keyboard and pushes every key, stamped with
+// the monotonic time it arrived, into a single-producer / single-consumer
+// lock-free ring. The game thread pops keys between frames, so keys typed
+// during an animation are neither lost nor applied in a late burst.
+// Without the thread the game thread calls read_raw itself with a timeout.
+
+#define INPUT_RING_SIZE 64          // Power of two
+#define INPUT_CLOSED    (-100)      // read_raw result: input is gone. Also the key handed out once the ring runs dry.
+#define INPUT_TIMEOUT   (-101)      // read_raw result: nothing within timeout_ms
+
+typedef struct {
+    int key;                        // K_* code from read_raw
+    double t_ms;                    // time_now_ms() when it was read
+} input_event_t;
+
+/*=======*/
+
+
+// ===== Input functions ======
+
+// ------ Lifetime ----
+int input_start(int (*read_raw)(int timeout_ms), int threaded);   // { read_raw - key reader (timeout_ms < 0 - forever), threaded - 1 run a reader thread } 0 if the thread failed
+
+// ------ Consumer side (game thread) ----
+int input_pending(void);                               // 1 if a key is queued
+int input_poll(input_event_t* ev);                     // { ev - out } Non-blocking pop. 1 if a key was taken.
+int input_wait(input_event_t* ev, double deadline);    // { deadline - time_now_ms() value, < 0 forever } Pop, sleeping until a key or the deadline
+int input_wait_pending(double deadline);               // Sleeps until a key is queued or the deadline. 1 if a key is queued.
+unsigned long input_dropped(void);                     // Keys lost because the ring was full
+
+/*=======*/
+
+
+#endif /* GAME_INPUT_H */
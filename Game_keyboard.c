@@ -0,0 +1,184 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L     // sigaction / poll under strict -std=c11
+#endif
+
+#include <stdlib.h>
+#include "Game_keyboard.h"
+#include "Game_time.h"
+
+#ifdef KBD_BACKEND_CONIO
+#include <conio.h>
+#include <windows.h>
+#else
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef KBD_BACKEND_CONIO
+
+// ===== conio backend ======
+
+int kbd_init(void) {
+    // The console already delivers single keys without echo through _getch
+    return 1;
+}
+
+void kbd_restore(void) {
+}
+
+int kbd_read(int timeout_ms) {   // { timeout_ms - < 0 wait forever }
+    // Waits on the console input handle, then decodes the 0/224 arrow prefix
+    HANDLE in = GetStdHandle(STD_INPUT_HANDLE);
+    double deadline = (timeout_ms >= 0) ? (time_now_ms() + timeout_ms) : (-1.0);
+    int key;
+
+    while (!_kbhit()) {
+        double left = (deadline < 0) ? (10.0) : (deadline - time_now_ms());
+
+        if (left <= 0) return KBD_TIMEOUT;
+
+        /* Mouse / focus events also signal the handle and _kbhit drops them, so wait in short slices */
+        WaitForSingleObject(in, (DWORD)((left < 10.0) ? (left + 1) : (10)));
+    }
+
+    key = _getch();
+
+    if (key == 0 || key == 224) {
+        switch (_getch()) {
+        case 72: return KBD_UP;
+        case 80: return KBD_DOWN;
+        case 75: return KBD_LEFT;
+        case 77: return KBD_RIGHT;
+        default: return KBD_UNKNOWN;
+        }
+    }
+
+    return (key == '\n') ? (KBD_ENTER) : (key);
+}
+
+/*=======*/
+
+#else
+
+// ===== termios backend ======
+
+#define ESC_SEQ_TIMEOUT_MS 30   // Bytes of one escape sequence arrive together; a lone ESC does not get a follow-up
+
+static struct termios saved_mode;
+static int raw_mode = 0;
+
+// ------ Terminal mode ----
+void kbd_restore(void) {
+    // Puts the terminal back into the mode it had before kbd_init
+    if (!raw_mode) return;
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_mode);
+    raw_mode = 0;
+}
+
+static void on_fatal_signal(int sig) {   // { sig - SIGINT / SIGTERM / SIGHUP }
+    // Restores the terminal before the default action kills the process
+    kbd_restore();
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+int kbd_init(void) {
+    // Switches the terminal to non-canonical, no-echo input. Output processing stays on,
+    // so "\n" still moves to the start of the next line.
+    struct termios raw;
+    struct sigaction sa;
+
+    if (raw_mode) return 1;
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &saved_mode) != 0) return 0;
+
+    raw = saved_mode;
+    raw.c_lflag &= (tcflag_t)~(ICANON | ECHO);
+    raw.c_iflag &= (tcflag_t)~(IXON);   /* Ctrl-S / Ctrl-Q reach the game instead of freezing output */
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) != 0) return 0;
+    raw_mode = 1;
+
+    atexit(kbd_restore);
+
+    sa.sa_handler = on_fatal_signal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGHUP, &sa, NULL);
+    return 1;
+}
+
+// ------ Byte input ----
+static int read_byte(int timeout_ms) {   // { timeout_ms - < 0 wait forever }
+    // One byte from stdin, KBD_TIMEOUT or KBD_CLOSED. Sleeps in poll(), never spins.
+    struct pollfd pfd;
+    double deadline = (timeout_ms >= 0) ? (time_now_ms() + timeout_ms) : (-1.0);
+    unsigned char ch;
+
+    pfd.fd = STDIN_FILENO;
+    pfd.events = POLLIN;
+
+    for (;;) {
+        int wait = -1;
+        int n;
+
+        if (deadline >= 0) {
+            double left = deadline - time_now_ms();
+            wait = (left > 0) ? ((int)left + 1) : (0);
+        }
+
+        n = poll(&pfd, 1, wait);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return KBD_CLOSED;
+        if (n == 0) {
+            if (deadline >= 0 && time_now_ms() >= deadline) return KBD_TIMEOUT;
+            continue;
+        }
+
+        n = (int)read(STDIN_FILENO, &ch, 1);
+        if (n == 1) return ch;
+        if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+        return KBD_CLOSED;
+    }
+}
+
+// ------ Key decoding ----
+int kbd_read(int timeout_ms) {   // { timeout_ms - < 0 wait forever }
+    // Reads one key; "ESC [ A".."ESC [ D" (and the "ESC O" application forms) become arrows
+    int ch = read_byte(timeout_ms);
+    int next;
+
+    if (ch < 0) return ch;
+    if (ch == '\r' || ch == '\n') return KBD_ENTER;
+    if (ch != 27) return ch;
+
+    next = read_byte(ESC_SEQ_TIMEOUT_MS);
+    if (next == KBD_TIMEOUT || next == KBD_CLOSED) return KBD_ESC;
+    if (next != '[' && next != 'O') return KBD_UNKNOWN;   /* Alt+key */
+
+    /* Parameters, then the final byte (0x40..0x7E) */
+    for (;;) {
+        int fin = read_byte(ESC_SEQ_TIMEOUT_MS);
+
+        if (fin < 0) return KBD_UNKNOWN;
+        if (fin < 0x40 || fin > 0x7E) continue;
+
+        switch (fin) {
+        case 'A': return KBD_UP;
+        case 'B': return KBD_DOWN;
+        case 'C': return KBD_RIGHT;
+        case 'D': return KBD_LEFT;
+        default:  return KBD_UNKNOWN;
+        }
+    }
+}
+
+/*=======*/
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef GAME_KEYBOARD_H
+#define GAME_KEYBOARD_H
+
+
+// ===== Keyboard backend ======
+//
+// One raw keyboard interface, two implementations picked at build time:
+//   conio   - Windows console (_getch / _kbhit, 0/224 arrow prefix)
+//   termios - POSIX terminals (raw mode, ANSI arrow sequences, poll() timeouts)
+// Windows builds use conio unless GAME_USE_TERMIOS is defined (Cygwin / MSYS terminals).
+
+#if defined(_WIN32) && !defined(GAME_USE_TERMIOS)
+#define KBD_BACKEND_CONIO   1
+#else
+#define KBD_BACKEND_TERMIOS 1
+#endif
+
+// ------ kbd_read results besides plain characters ----
+#define KBD_TIMEOUT   (-1)     // Nothing arrived within timeout_ms
+#define KBD_CLOSED    (-2)     // End of input (stdin closed)
+#define KBD_ENTER     13       // Enter, whatever the terminal sends for it
+#define KBD_ESC       27       // A lone Escape
+#define KBD_UP        0x101
+#define KBD_DOWN      0x102
+#define KBD_LEFT      0x103
+#define KBD_RIGHT     0x104
+#define KBD_UNKNOWN   0x1FF    // A special key we do not map
+
+/*=======*/
+
+
+// ===== Keyboard functions ======
+
+int  kbd_init(void);              // Raw mode (restored at exit). 0 if stdin is not a terminal (still readable)
+void kbd_restore(void);           // Back to the mode the terminal had before kbd_init
+int  kbd_read(int timeout_ms);    // { timeout_ms - < 0 wait forever } Next key, KBD_TIMEOUT or KBD_CLOSED
+
+/*=======*/
+
+
+#endif /* GAME_KEYBOARD_H */
@@ -1,28 +1,79 @@
 #include <stdio.h>
-#include <conio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "Game_config.h"
+#include "Game_geometry.h"
+#include "Game_input.h"
+#include "Game_keyboard.h"
 
 
 // ===== Function declarations ======
 
-// ------ Keyboard input ----
-int read_key(void);   // Read a key from the keyboard and return K_* code
-
 // ------ Score printing ----
 void print_score(int drow, int first, int second);   // { drow - draws, first - Player 1 wins, second - Player 2 wins }
+void print_render_stats(void);                        // Frame / byte / syscall counters of the renderer
 
 /*=======*/
 
 
 // ===== Main function ======
 
-int main(void) {
+int main(int argc, char** argv) {
     int selected = 0;                 // Current selected menu option index
     int score[3] = { 0, 0, 0 };        // { score[0] - draws, score[1] - Player 1 wins, score[2] - Player 2 wins }
+    int hash_mb = AI_HASH_MB_DEFAULT;  // AI transposition table size
+    int huge_pages = 0;                // 1 - try to back the table with large pages
+    int time_ms = AI_TIME_MS_DEFAULT;  // Per-move think time of the search AI
+    int threads = AI_THREADS_DEFAULT;  // Search workers
+    const char* book = AI_BOOK_DEFAULT; // Opening book file (optional)
+    const char* egdb = AI_EGDB_DEFAULT; // Endgame database file (optional)
+    int render_stats = 0;              // 1 - print frame / syscall counters on exit
+    int full_redraw = 0;               // 1 - send every drawn byte instead of the changed cells
+    int ponder = 0;                    // 1 - EXPERT AI thinks on the human's time
+    const char* board = NULL;          // "<cols>x<rows>" (NULL - COLS x ROWS; other sizes play on a geometry kernel)
+    int board_cols = COLS, board_rows = ROWS;
+
+    // ------ Startup options ----
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--hash") && i + 1 < argc) hash_mb = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--large-pages"))     huge_pages = 1;
+        else if (!strcmp(argv[i], "--time") && i + 1 < argc) time_ms = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--book") && i + 1 < argc) book = argv[++i];
+        else if (!strcmp(argv[i], "--egdb") && i + 1 < argc) egdb = argv[++i];
+        else if (!strcmp(argv[i], "--render-stats"))    render_stats = 1;
+        else if (!strcmp(argv[i], "--full-redraw"))     full_redraw = 1;
+        else if (!strcmp(argv[i], "--ponder"))          ponder = 1;
+        else if (!strcmp(argv[i], "--board") && i + 1 < argc) board = argv[++i];
+    }
+
+    if (board && sscanf(board, "%dx%d", &board_cols, &board_rows) != 2) board_cols = 0;
+    if (!game_set_board(board_cols, board_rows)) {
+        printf("No %s board. Sizes built:", board);
+        for (int i = 0; i < geo_kernel_count(); i++) printf(" %s", geo_kernel_at(i)->name);
+        printf("\n");
+        return 1;
+    }
+
+    ui_set_diff(!full_redraw);
+    ai_set_move_time(time_ms);
+    ai_set_threads(threads);
+    ai_set_ponder(ponder);
+
+    if (!ai_init(hash_mb, huge_pages)) {
+        printf("Could not allocate a %d MB transposition table.\n", hash_mb);
+        return 1;
+    }
+
+    ai_open_book(book);                // Playing without a book is fine
+    ai_open_egdb(egdb);                // Or without an endgame database
+
+    kbd_init();                        // Raw keyboard on POSIX terminals (restored at exit)
+    input_start(read_key_raw, 1);      // Without the thread read_key waits on the keyboard itself
 
     // ------ Cursor control ----
-    printf(ANSI_HIDE_CURSOR);          // Hide the cursor
-    fflush(stdout);
+    ui_printf(ANSI_HIDE_CURSOR);       // Hide the cursor
+    ui_flush();
 
     // ------ Menu render (static) ----
     ui_menu_init();
@@ -54,30 +105,35 @@ int main(void) {
             switch (selected) {
 
                 // ------ Game modes ----
-            case 0:
-            case 1:
-            case 2:
+            case MODE_PVP:
+            case MODE_AI_EASY:
+            case MODE_AI_HARD:
+            case MODE_AI_EXPERT:
+            case MODE_AI_MCTS:
                 temp = start_game(selected);
                 if (temp >= 0) score[temp]++;     // If the game returns a result, save it
                 break;
 
                 // ------ Statistics ----
-            case 3:
+            case MENU_OPTIONS - 3:
                 print_score(score[0], score[1], score[2]);
                 break;
 
                 // ------ Manual / help ----
-            case 4:
+            case MENU_OPTIONS - 2:
                 ui_display_manual();
                 break;
 
                 // ------ Exit option ----
             case MENU_OPTIONS - 1:
+                ui_flush();
+                if (render_stats) print_render_stats();
+                ai_shutdown();
                 exit(0);                          // Exit from menu
                 break;
 
             default:
-                printf("Unknown option.\n");
+                ui_printf("Unknown option.\n");
                 break;
             }
 
@@ -88,8 +144,10 @@ int main(void) {
 
             // ------ ESC exit ----
         case K_ESC:
-            printf(ANSI_SHOW_CURSOR ANSI_RESET);
-            fflush(stdout);
+            ui_printf(ANSI_SHOW_CURSOR ANSI_RESET);
+            ui_flush();
+            if (render_stats) print_render_stats();
+            ai_shutdown();
             return 0;
 
         default:
@@ -107,15 +165,33 @@ int main(void) {
 void print_score(int drow, int first, int second) {   // { drow - draws, first - Player 1 wins, second - Player 2 wins }
     // Prints the score table and waits for key press
 
-    printf("+----------------------------------------------------+\n");
-    printf(ANSI_FG_CYAN "SCORE: " ANSI_RESET);
-    printf(ANSI_FG_RED "Player 1\t\t" ANSI_FG_YELLOW "Player 2\t" ANSI_FG_GRAY "Draw\n" ANSI_RESET);
-    printf("+----------------------------------------------------+\n");
-    printf("\t%d\t\t%d\t\t%d\n", first, second, drow);
-    printf("+----------------------------------------------------+\n");
-    printf(ANSI_FG_GRAY "Press any key to return...." ANSI_RESET);
+    ui_printf("+----------------------------------------------------+\n");
+    ui_printf(ANSI_FG_CYAN "SCORE: " ANSI_RESET);
+    ui_printf(ANSI_FG_RED "Player 1\t\t" ANSI_FG_YELLOW "Player 2\t" ANSI_FG_GRAY "Draw\n" ANSI_RESET);
+    ui_printf("+----------------------------------------------------+\n");
+    ui_printf("\t%d\t\t%d\t\t%d\n", first, second, drow);
+    ui_printf("+----------------------------------------------------+\n");
+    ui_printf(ANSI_FG_GRAY "Press any key to return...." ANSI_RESET);
 
-    _getch();
+    ui_getch();
+}
+
+// ------ Renderer counters ----
+void print_render_stats(void) {
+    // Prints how many frames, bytes and write() calls the session cost (--render-stats)
+    ui_frame_stats_t st;
+    ui_frame_stats(&st);
+
+    printf("\n%lu frames, %llu bytes, %lu writes, %llu cells", st.frames, st.bytes, st.writes, st.cells);
+    if (st.frames) {
+        printf(" | per frame: %.1f bytes, %.2f writes", (double)st.bytes / st.frames, (double)st.writes / st.frames);
+    }
+    if (st.input_frames) {
+        printf("\nkeypress to frame: avg %.2f ms, max %.2f ms over %lu keys",
+            st.input_ms_total / st.input_frames, st.input_ms_max, st.input_frames);
+    }
+    if (input_dropped()) printf(", %lu keys dropped", input_dropped());
+    printf("\n");
 }
 
 /*=======*/
@@ -123,32 +199,50 @@ void print_score(int drow, int first, int second) {   // { drow - draws, first -
 
 // ===== Input functions ======
 
-// ------ Read key from keyboard ----
+// ------ Next key for the game thread ----
 int read_key(void) {
-    // Reads key press and converts to K_* codes
-
-    int key = _getch();
-
-    // ------ Arrow keys handling ----
-    if (key == 0 || key == 224) {
-        key = _getch();
-        switch (key) {
-        case 72: return K_UP;
-        case 80: return K_DOWN;
-        case 75: return K_LEFT;
-        case 77: return K_RIGHT;
-        default: return K_NONE;
-        }
+    // Pops the next key; the pending frame is only flushed when nothing is queued,
+    // so a burst of keys is applied before the screen is redrawn once
+    input_event_t ev;
+
+    if (!input_poll(&ev)) {
+        ui_flush();
+        input_wait(&ev, -1);
+    }
+
+    ui_mark_input(ev.t_ms);
+    return (ev.key == INPUT_CLOSED) ? (K_ESC) : (ev.key);   /* End of input backs out of every screen */
+}
+
+// ------ Read key from keyboard ----
+int read_key_raw(int timeout_ms) {   // { timeout_ms - < 0 wait forever }
+    // Reads key press and converts to K_* codes (runs on the input thread)
+
+    int key = kbd_read(timeout_ms);
+
+    // ------ Backend results ----
+    switch (key) {
+    case KBD_TIMEOUT: return INPUT_TIMEOUT;
+    case KBD_CLOSED:  return INPUT_CLOSED;
+    case KBD_UP:      return K_UP;
+    case KBD_DOWN:    return K_DOWN;
+    case KBD_LEFT:    return K_LEFT;
+    case KBD_RIGHT:   return K_RIGHT;
+    default:          break;
     }
 
     // ------ Single-byte keys handling ----
     switch (key) {
-    case 13:  return K_ENTER;   // Enter
-    case ' ': return K_ENTER;   // Space
-    case 27:  return K_ESC;     // Esc
+    case KBD_ENTER: return K_ENTER;   // Enter
+    case ' ':       return K_ENTER;   // Space
+    case KBD_ESC:   return K_ESC;     // Esc
     case 'r':
-    case 'R': return K_RESET;   // Reset
-    default:  return K_NONE;
+    case 'R':       return K_RESET;   // Reset
+    case 'u':
+    case 'U':       return K_UNDO;    // Take a move back
+    case 'y':
+    case 'Y':       return K_REDO;    // Replay an undone move
+    default:        return K_NONE;
     }
 }
 
@@ -0,0 +1,331 @@
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <threads.h>
+#include "Game_board.h"
+#include "Game_mcts.h"
+#include "Game_rng.h"
+#include "Game_time.h"
+
+
+// ===== Tree storage ======
+
+#define MCTS_LEAF       -1          // children: not expanded yet
+#define MCTS_BUSY       -2          // children: a worker is expanding the node
+
+#define MCTS_RUNNING    0           // terminal: game goes on
+#define MCTS_WON        1           // terminal: the move into the node won
+#define MCTS_DRAWN      2           // terminal: the move into the node filled the board
+
+typedef struct {
+    atomic_int visits;      // Descents through the node, the ones still running included
+    atomic_int reward;      // Half points for the player who moved into the node (2 win, 1 draw)
+    atomic_int children;    // Index of the first child, or MCTS_LEAF / MCTS_BUSY
+    uint8_t count;          // Number of children (legal moves)
+    uint8_t col;            // Column played to reach the node
+    uint8_t terminal;       // MCTS_RUNNING / MCTS_WON / MCTS_DRAWN
+    uint8_t pad;
+} mcts_node_t;
+
+struct mcts_s {
+    mcts_node_t* nodes;     // Arena; node 0 is the root
+    uint32_t cap;           // Capacity in nodes
+    atomic_uint top;        // Next free node
+};
+
+// ------ Per-thread worker ----
+typedef struct {
+    mcts_t* m;
+    const board_t* root;
+    const mcts_params_t* params;
+    atomic_int* stop;       // Raised by the first worker that sees time or simulations run out
+    double deadline;        // time_now_ms() value to stop at (0 - no limit)
+    atomic_ullong* sims;    // Shared playout counter (for max_sims)
+    rng_t rng;              // Worker-private playout generator
+    uint64_t done;          // Playouts run by this worker
+} mcts_worker_t;
+
+#define MCTS_CHECK_SIMS 63          // Limits are checked once every 64 playouts
+
+/*=======*/
+
+
+// ===== Arena ======
+
+// ------ Lifetime ----
+mcts_t* mcts_create(size_t nodes) {   // { nodes - arena capacity }
+    // Allocates the arena once. calloc maps large blocks lazily, so untouched nodes cost no memory.
+    mcts_t* m;
+
+    if (nodes < 2 * COLS) nodes = 2 * COLS;
+    if (nodes > 0x7FFFFFFF) nodes = 0x7FFFFFFF;
+
+    m = (mcts_t*)calloc(1, sizeof(*m));
+    if (!m) return NULL;
+
+    m->nodes = (mcts_node_t*)calloc(nodes, sizeof(*m->nodes));
+    if (!m->nodes) {
+        free(m);
+        return NULL;
+    }
+
+    m->cap = (uint32_t)nodes;
+    atomic_init(&m->top, 1);
+    return m;
+}
+
+void mcts_destroy(mcts_t* m) {
+    if (!m) return;
+    free(m->nodes);
+    free(m);
+}
+
+// ------ Nodes ----
+static void node_init(mcts_node_t* n, int col, int terminal) {   // { col - move into the node, terminal - MCTS_* }
+    atomic_store_explicit(&n->visits, 0, memory_order_relaxed);
+    atomic_store_explicit(&n->reward, 0, memory_order_relaxed);
+    atomic_store_explicit(&n->children, MCTS_LEAF, memory_order_relaxed);
+    n->count = 0;
+    n->col = (uint8_t)col;
+    n->terminal = (uint8_t)terminal;
+}
+
+static int expand(mcts_t* m, mcts_node_t* n, const board_t* b) {   // { n - leaf owned by this worker (MCTS_BUSY), b - its position }
+    // Gives n one child per legal column, center-first. Returns 0 (and leaves n a leaf) once the arena is full.
+    int player = board_player_to_move(b);
+    int cols[COLS];
+    int count = 0;
+    uint32_t first;
+
+    for (int i = 0; i < COLS; i++) {
+        int c = COLS / 2 + ((i % 2) ? (i + 1) / 2 : -(i + 1) / 2);
+        if (board_can_play(b, c)) cols[count++] = c;
+    }
+
+    /* Check before reserving, so a full arena does not keep growing `top` */
+    if (atomic_load_explicit(&m->top, memory_order_relaxed) + (uint32_t)count > m->cap
+        || (first = atomic_fetch_add_explicit(&m->top, (uint32_t)count, memory_order_relaxed)) + (uint32_t)count > m->cap) {
+        atomic_store_explicit(&n->children, MCTS_LEAF, memory_order_relaxed);
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        board_t child = *b;
+        int terminal = MCTS_RUNNING;
+
+        board_drop(&child, cols[i], player);
+        if (board_has_won(&child, player))  terminal = MCTS_WON;
+        else if (board_is_full(&child))     terminal = MCTS_DRAWN;
+
+        node_init(&m->nodes[first + i], cols[i], terminal);
+    }
+
+    n->count = (uint8_t)count;
+    atomic_store_explicit(&n->children, (int)first, memory_order_release);   /* Publishes the initialized children */
+    return 1;
+}
+
+/*=======*/
+
+
+// ===== Simulation ======
+
+// ------ Random playout ----
+static int playout(board_t* b, rng_t* rng) {   // { b - running position (consumed) }
+    // Plays uniform random moves to the end, but always takes an immediate win. Returns the winner, 0 on a draw.
+    for (;;) {
+        int player = board_player_to_move(b);
+        int col;
+
+        if (board_winning_moves(b, player)) return player;
+
+        /* Any column first; only a full one costs the bounded pick among the rest */
+        col = rng_below(rng, COLS);
+        if (!board_can_play(b, col)) col = rng_pick(rng, board_column_mask(b));
+
+        board_drop(b, col, player);
+        if (board_is_full(b)) return 0;
+    }
+}
+
+// ------ UCT selection ----
+static mcts_node_t* select_child(mcts_t* m, mcts_node_t* n, int first) {   // { n - expanded node, first - its first child }
+    // Returns the child with the best upper confidence bound; unvisited children come first
+    double log_n = log((double)atomic_load_explicit(&n->visits, memory_order_relaxed) + 1.0);
+    mcts_node_t* best = NULL;
+    double best_u = -1.0;
+
+    for (int i = 0; i < n->count; i++) {
+        mcts_node_t* c = &m->nodes[first + i];
+        int v = atomic_load_explicit(&c->visits, memory_order_relaxed);
+        double u;
+
+        if (v == 0) return c;
+
+        u = atomic_load_explicit(&c->reward, memory_order_relaxed) / (2.0 * v) + MCTS_EXPLORE * sqrt(log_n / v);
+        if (u > best_u) {
+            best_u = u;
+            best = c;
+        }
+    }
+    return best;
+}
+
+// ------ One simulation ----
+static void simulate(mcts_worker_t* w) {
+    // Select down to a leaf, expand it if it has been visited before, play out, and back the result up the path
+    mcts_t* m = w->m;
+    mcts_node_t* path[BOARD_CELLS + 1];
+    board_t b = *w->root;
+    mcts_node_t* n = &m->nodes[0];
+    int len = 0;
+    int winner;
+
+    atomic_fetch_add_explicit(&n->visits, 1, memory_order_relaxed);
+    path[len++] = n;
+
+    for (;;) {
+        int first;
+
+        if (n->terminal == MCTS_WON) { winner = (b.moves & 1) ? PLAYER_1 : PLAYER_2; break; }   /* The player who just moved */
+        if (n->terminal == MCTS_DRAWN) { winner = 0; break; }
+
+        first = atomic_load_explicit(&n->children, memory_order_acquire);
+        if (first == MCTS_LEAF && atomic_load_explicit(&n->visits, memory_order_relaxed) >= MCTS_EXPAND_VISITS) {
+            int leaf = MCTS_LEAF;
+            if (atomic_compare_exchange_strong(&n->children, &leaf, MCTS_BUSY) && expand(m, n, &b)) {
+                first = atomic_load_explicit(&n->children, memory_order_relaxed);
+            }
+        }
+        if (first < 0) {   /* Leaf, or another worker is expanding it: play out from here */
+            winner = playout(&b, &w->rng);
+            break;
+        }
+
+        n = select_child(m, n, first);
+        atomic_fetch_add_explicit(&n->visits, 1, memory_order_relaxed);   /* Virtual loss until the result is added */
+        board_drop(&b, n->col, board_player_to_move(&b));
+        path[len++] = n;
+    }
+
+    /* path[i] was reached by the player who made move root.moves + i */
+    for (int i = 0; i < len; i++) {
+        int mover = ((w->root->moves + i) & 1) ? PLAYER_1 : PLAYER_2;
+        int half = (winner == 0) ? 1 : (winner == mover) ? 2 : 0;
+        if (half) atomic_fetch_add_explicit(&path[i]->reward, half, memory_order_relaxed);
+    }
+}
+
+// ------ Worker loop ----
+static int worker_main(void* arg) {   // { arg - mcts_worker_t }
+    // Runs simulations in rounds of 64 until a worker sees the clock or the simulation limit run out
+    mcts_worker_t* w = (mcts_worker_t*)arg;
+
+    for (;;) {
+        for (int i = 0; i <= MCTS_CHECK_SIMS; i++) simulate(w);
+        w->done += MCTS_CHECK_SIMS + 1;
+
+        unsigned long long total = atomic_fetch_add_explicit(w->sims, MCTS_CHECK_SIMS + 1, memory_order_relaxed) + MCTS_CHECK_SIMS + 1;
+
+        if (atomic_load_explicit(w->stop, memory_order_relaxed)) break;
+        if ((w->params->max_sims && total >= w->params->max_sims)
+            || (w->deadline > 0 && time_now_ms() >= w->deadline)) {
+            atomic_store_explicit(w->stop, 1, memory_order_relaxed);
+            break;
+        }
+    }
+    return 0;
+}
+
+/*=======*/
+
+
+// ===== Search entry point ======
+
+int mcts_best_move(mcts_t* m, const board_t* b, const mcts_params_t* params, mcts_result_t* out) {   // { m - arena, b - position, params - limits, out - stats (can be NULL) }
+    // Builds a fresh tree for b with params->threads workers. Returns the most visited root move, or -1 if the board is full.
+    mcts_worker_t workers[MCTS_MAX_THREADS];
+    thrd_t handles[MCTS_MAX_THREADS];
+    atomic_int stop;
+    atomic_ullong sims;
+    double start = time_now_ms();
+    int threads = params->threads;
+    int spawned = 1;
+    mcts_node_t* root = &m->nodes[0];
+    int best_col = -1;
+    double value = 0.0;
+
+    if (board_is_full(b)) return -1;
+    if (threads < 1) threads = 1;
+    if (threads > MCTS_MAX_THREADS) threads = MCTS_MAX_THREADS;
+
+    /* A fresh tree: only the root and its children */
+    atomic_store_explicit(&m->top, 1, memory_order_relaxed);
+    node_init(root, 0, MCTS_RUNNING);
+    atomic_store_explicit(&root->children, MCTS_BUSY, memory_order_relaxed);
+    expand(m, root, b);
+
+    atomic_init(&stop, 0);
+    atomic_init(&sims, 0);
+
+    for (int i = 0; i < threads; i++) {
+        mcts_worker_t* w = &workers[i];
+
+        w->m = m;
+        w->root = b;
+        w->params = params;
+        w->stop = &stop;
+        w->deadline = (params->time_ms > 0) ? (start + params->time_ms) : (0);
+        w->sims = &sims;
+        rng_seed(&w->rng, ((params->seed) ? (params->seed) : ((uint64_t)(start * 1000.0) * 0x9E3779B97F4A7C15ULL)) + (uint64_t)i);
+        w->done = 0;
+    }
+
+    for (int i = 1; i < threads; i++) {
+        if (thrd_create(&handles[i], worker_main, &workers[i]) != thrd_success) break;
+        spawned++;
+    }
+
+    worker_main(&workers[0]);
+    atomic_store(&stop, 1);
+
+    for (int i = 1; i < spawned; i++) thrd_join(handles[i], NULL);
+
+    /* A move that wins at once needs no statistics; otherwise the most visited move is the most trusted one */
+    {
+        int first = atomic_load(&root->children);
+        int best_visits = -1;
+
+        for (int i = 0; i < root->count; i++) {
+            mcts_node_t* c = &m->nodes[first + i];
+            int v = atomic_load(&c->visits);
+
+            if (c->terminal == MCTS_WON) {
+                best_col = c->col;
+                value = 1.0;
+                break;
+            }
+            if (v > best_visits) {
+                best_visits = v;
+                best_col = c->col;
+                value = (v) ? (atomic_load(&c->reward) / (2.0 * v)) : (0.5);
+            }
+        }
+    }
+
+    if (out) {
+        out->best_col = best_col;
+        out->value = value;
+        out->sims = 0;
+        for (int i = 0; i < spawned; i++) out->sims += workers[i].done;
+        out->nodes = atomic_load(&m->top);
+        if (out->nodes > m->cap) out->nodes = m->cap;
+        out->arena_full = (atomic_load(&m->top) + COLS > m->cap);
+        out->threads = spawned;
+        out->ms = time_now_ms() - start;
+    }
+
+    return best_col;
+}
+
+/*=======*/
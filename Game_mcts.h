@@ -0,0 +1,56 @@
+#ifndef GAME_MCTS_H
+#define GAME_MCTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Game_board.h"
+
+
+// ===== Monte Carlo tree search ======
+//
+// UCT over a tree whose nodes come from one preallocated arena. Every worker
+// thread descends the same tree. Node statistics are relaxed atomics, and a
+// descent bumps the visit count before its playout result is known. That
+// visit is the virtual loss: it steers the other workers to other branches
+// until the result arrives.
+
+#define MCTS_DEFAULT_NODES  (1u << 22)  // Arena size used by the game (16 bytes per node)
+#define MCTS_MAX_THREADS    256
+#define MCTS_EXPLORE        1.4         // UCT exploration constant
+#define MCTS_EXPAND_VISITS  2           // A leaf gets children on its second visit
+
+typedef struct mcts_s mcts_t;
+
+typedef struct {
+    int time_ms;            // Wall-clock budget (0 - stop on max_sims only)
+    int threads;            // Workers sharing the tree
+    uint64_t max_sims;      // Simulation limit (0 - none)
+    uint64_t seed;          // Playout generator seed; worker i uses seed + i (0 - from the clock)
+} mcts_params_t;
+
+typedef struct {
+    int best_col;           // Most visited root move (-1 if the board is full)
+    double value;           // Its expected result for the side to move (0 loss .. 1 win)
+    uint64_t sims;          // Playouts run by all workers
+    uint32_t nodes;         // Arena nodes used
+    int arena_full;         // 1 - the tree stopped growing; later playouts started from its leaves
+    int threads;            // Workers that took part
+    double ms;              // Wall-clock time spent
+} mcts_result_t;
+
+/*=======*/
+
+
+// ===== MCTS functions ======
+
+// ------ Lifetime ----
+mcts_t* mcts_create(size_t nodes);        // { nodes - arena capacity } NULL on failure
+void    mcts_destroy(mcts_t* m);          // NULL is ignored
+
+// ------ Search ----
+int mcts_best_move(mcts_t* m, const board_t* b, const mcts_params_t* params, mcts_result_t* out);   // { out - stats (can be NULL) } Column, -1 if full
+
+/*=======*/
+
+
+#endif /* GAME_MCTS_H */
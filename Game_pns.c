@@ -0,0 +1,315 @@
+#include <stdlib.h>
+#include <string.h>
+#include "Game_pns.h"
+#include "Game_time.h"
+
+#if COLS * BOARD_H1 > 62
+#error "Board keys collide with the attacker tag of the proof-number table"
+#endif
+
+
+// ===== Table ======
+//
+// Entries are keyed by board_canonical_key() tagged with the attacker in
+// the top two bits: the same position means something else when the other
+// side is the one trying to win. The tag also keeps every key non-zero, so
+// key 0 marks an empty entry. Entries survive between proofs; finished
+// numbers (0 / PNS_INF) stay exact, the others are only estimates anyway.
+
+typedef struct {
+    uint64_t key;           // Tagged canonical key (0 - empty)
+    uint32_t phi;
+    uint32_t delta;
+    uint64_t work;          // Nodes expanded below the entry when stored (replacement priority)
+} pns_entry_t;
+
+typedef struct {
+    pns_entry_t e[PNS_BUCKET_SIZE];
+} pns_bucket_t;
+
+struct pns_s {
+    pns_bucket_t* buckets;
+    uint64_t count;         // Number of buckets (power of two)
+    int shift;              // 64 - log2(count)
+};
+
+static pns_bucket_t* bucket_of(const pns_t* pns, uint64_t key) {
+    // Fibonacci hashing, like Game_tt.c
+    return &pns->buckets[(key * 0x9E3779B97F4A7C15ULL) >> pns->shift];
+}
+
+static int lookup(const pns_t* pns, uint64_t key, uint32_t* phi, uint32_t* delta) {   // { key - tagged key, phi/delta - out }
+    pns_bucket_t* bk = bucket_of(pns, key);
+
+    for (int i = 0; i < PNS_BUCKET_SIZE; i++) {
+        if (bk->e[i].key == key) {
+            *phi = bk->e[i].phi;
+            *delta = bk->e[i].delta;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void store(pns_t* pns, uint64_t key, uint32_t phi, uint32_t delta, uint64_t work) {   // { work - nodes spent below key }
+    // Overwrites key's entry, else an empty one, else the one with the least work
+    pns_bucket_t* bk = bucket_of(pns, key);
+    pns_entry_t* victim = &bk->e[0];
+
+    for (int i = 0; i < PNS_BUCKET_SIZE; i++) {
+        pns_entry_t* e = &bk->e[i];
+
+        if (e->key == key || !e->key) {
+            victim = e;
+            break;
+        }
+        if (e->work < victim->work) victim = e;
+    }
+
+    victim->key = key;
+    victim->phi = phi;
+    victim->delta = delta;
+    victim->work = work;
+}
+
+// ------ Lifetime ----
+pns_t* pns_create(size_t mb) {   // { mb - table size in MB }
+    // Allocates the largest power-of-two bucket count that fits in mb
+    pns_t* pns = (pns_t*)calloc(1, sizeof(*pns));
+    size_t bytes;
+
+    if (!pns) return NULL;
+    if (mb < 1) mb = 1;
+    if (mb > PNS_MAX_MB) mb = PNS_MAX_MB;
+
+    bytes = mb * 1024 * 1024;
+    pns->count = 1;
+    pns->shift = 64;
+    while (pns->count * 2 * sizeof(pns_bucket_t) <= bytes) {
+        pns->count *= 2;
+        pns->shift--;
+    }
+
+    pns->buckets = (pns_bucket_t*)calloc((size_t)pns->count, sizeof(pns_bucket_t));
+    if (!pns->buckets) {
+        free(pns);
+        return NULL;
+    }
+    return pns;
+}
+
+void pns_destroy(pns_t* pns) {
+    if (!pns) return;
+    free(pns->buckets);
+    free(pns);
+}
+
+void pns_clear(pns_t* pns) {
+    if (pns) memset(pns->buckets, 0, (size_t)pns->count * sizeof(pns_bucket_t));
+}
+
+/*=======*/
+
+
+// ===== Depth-first proof-number search ======
+
+typedef struct {
+    pns_t* pns;
+    board_t b;              // Current position (make / unmake)
+    int attacker;           // Side the proof is for (PLAYER_1 / PLAYER_2)
+    uint64_t tag;           // Attacker tag ORed into every key
+    uint64_t nodes;         // Nodes expanded
+    uint64_t max_nodes;     // Budget
+    double deadline;        // time_now_ms() value to stop at (0 - no limit)
+    uint64_t next_check;    // Node count at which the clock is read next
+    int stop;               // Latched once a budget ran out; every node then unwinds
+    int root_moves;         // Chips on the board at the root
+    int best_col;           // Root reply with the smallest delta at the last root update
+} pns_search_t;
+
+static inline uint32_t add_sat(uint32_t a, uint32_t b) {
+    // Sum capped below PNS_INF; PNS_INF stays PNS_INF
+    uint64_t s = (uint64_t)a + b;
+    if (a >= PNS_INF || b >= PNS_INF) return PNS_INF;
+    return (s >= PNS_INF) ? (PNS_INF - 1) : ((uint32_t)s);
+}
+
+static inline int bit_count(bitboard_t x) {
+    int n = 0;
+    for (; x; x &= x - 1) n++;
+    return n;
+}
+
+static int out_of_budget(pns_search_t* s) {
+    // Node budget on every call, the clock every 1024 nodes (a proof node costs well under a microsecond)
+    if (!s->stop && s->nodes >= s->max_nodes) s->stop = 1;
+    if (!s->stop && s->deadline > 0 && s->nodes >= s->next_check) {
+        s->next_check = s->nodes + 1024;
+        if (time_now_ms() >= s->deadline) s->stop = 1;
+    }
+    return s->stop;
+}
+
+// ------ Leaf values ----
+static int leaf(const pns_search_t* s, const board_t* b, uint32_t* phi, uint32_t* delta, bitboard_t* moves) {   // { moves - out: replies to expand }
+    // Numbers of a position before it is expanded. Returns 1 if it is decided already.
+    int player = board_player_to_move(b);
+
+    if (board_winning_moves(b, player)) {
+        *phi = 0;
+        *delta = PNS_INF;
+        return 1;
+    }
+    if (board_is_full(b)) {
+        /* A draw is a win for the defender */
+        *phi = (player == s->attacker) ? (PNS_INF) : (0);
+        *delta = (player == s->attacker) ? (0) : (PNS_INF);
+        return 1;
+    }
+
+    *moves = board_safe_moves(b);
+    if (!*moves) {
+        *phi = PNS_INF;     /* Every move lets the opponent win next */
+        *delta = 0;
+        return 1;
+    }
+
+    *phi = 1;
+    *delta = (uint32_t)bit_count(*moves);   /* Every reply costs one proof */
+    return 0;
+}
+
+static void child_numbers(pns_search_t* s, int col, uint32_t* phi, uint32_t* delta) {   // { col - reply to look at }
+    // Table entry of the position after col, else its leaf values
+    int player = board_player_to_move(&s->b);
+    int mirrored;
+    bitboard_t moves;
+
+    board_drop(&s->b, col, player);
+    if (!lookup(s->pns, board_canonical_key(&s->b, &mirrored) | s->tag, phi, delta)) leaf(s, &s->b, phi, delta, &moves);
+    board_undo(&s->b, col);
+}
+
+// ------ Multiple iterative deepening ----
+static void mid(pns_search_t* s, uint32_t th_phi, uint32_t th_delta, uint32_t* out_phi, uint32_t* out_delta) {   // { th_phi/th_delta - return once a number reaches them }
+    // Expands the current position until its phi or delta reaches its threshold or the budget runs out
+    int mirrored;
+    uint64_t key = board_canonical_key(&s->b, &mirrored) | s->tag;
+    uint64_t start = s->nodes;
+    uint32_t phi, delta;
+    uint32_t cphi[COLS], cdelta[COLS];
+    int cols[COLS];
+    int n = 0;
+    bitboard_t moves;
+
+    s->nodes++;
+
+    if (leaf(s, &s->b, &phi, &delta, &moves)) {
+        store(s->pns, key, phi, delta, 1);
+        *out_phi = phi;
+        *out_delta = delta;
+        return;
+    }
+
+    for (int i = 0; i < COLS; i++) {
+        int c = COLS / 2 + ((i % 2) ? (i + 1) / 2 : -(i + 1) / 2);
+        if (!(moves & bitboard_column(c))) continue;
+
+        cols[n] = c;
+        child_numbers(s, c, &cphi[n], &cdelta[n]);
+        n++;
+    }
+
+    for (;;) {
+        uint32_t delta2 = PNS_INF;
+        int best = 0;
+
+        /* phi = min child delta, delta = sum of child phi (center-first on ties) */
+        phi = PNS_INF;
+        delta = 0;
+        for (int i = 0; i < n; i++) {
+            if (cdelta[i] < phi) {
+                delta2 = phi;
+                phi = cdelta[i];
+                best = i;
+            }
+            else if (cdelta[i] < delta2) {
+                delta2 = cdelta[i];
+            }
+            delta = add_sat(delta, cphi[i]);
+        }
+
+        if (s->b.moves == s->root_moves) s->best_col = cols[best];
+        if (phi >= th_phi || delta >= th_delta || out_of_budget(s)) break;
+
+        /* The best reply may spend our delta slack, and its delta may grow up to just past the second best */
+        {
+            uint64_t c_phi = (uint64_t)th_delta - delta + cphi[best];
+            uint64_t c_delta = (uint64_t)delta2 + 1;
+            int player = board_player_to_move(&s->b);
+
+            if (delta2 < PNS_INF && delta2 / 4 > 1) c_delta = (uint64_t)delta2 + delta2 / 4;
+            if (th_delta >= PNS_INF || c_phi > PNS_INF) c_phi = PNS_INF;
+            if (c_delta > th_phi) c_delta = th_phi;
+
+            board_drop(&s->b, cols[best], player);
+            mid(s, (uint32_t)c_phi, (uint32_t)c_delta, &cphi[best], &cdelta[best]);
+            board_undo(&s->b, cols[best]);
+        }
+    }
+
+    store(s->pns, key, phi, delta, s->nodes - start);
+    *out_phi = phi;
+    *out_delta = delta;
+}
+
+// ------ Root ----
+int pns_prove(pns_t* pns, const board_t* b, uint64_t max_nodes, int time_ms, pns_result_t* out) {   // { pns - table, b - position, max_nodes - budget, time_ms - 0 no limit, out - stats (can be NULL) }
+    // Tries to prove that the side to move forces a win within max_nodes expansions and time_ms
+    pns_search_t s;
+    pns_result_t res = { PNS_UNKNOWN, -1, 1, 1, 0, 0.0 };
+    double start = time_now_ms();
+    int player = board_player_to_move(b);
+
+    if (board_is_full(b)) {
+        res.result = PNS_DISPROVEN;
+        res.phi = PNS_INF;
+        res.delta = 0;
+    }
+    else if (board_winning_moves(b, player)) {
+        res.result = PNS_PROVEN;
+        res.best_col = board_move_column(board_winning_moves(b, player));
+        res.phi = 0;
+        res.delta = PNS_INF;
+    }
+    else {
+        s.pns = pns;
+        s.b = *b;
+        s.attacker = player;
+        s.tag = (uint64_t)player << 62;
+        s.nodes = 0;
+        s.max_nodes = (max_nodes) ? (max_nodes) : (1);
+        s.deadline = (time_ms > 0) ? (start + time_ms) : (0);
+        s.next_check = 1024;
+        s.stop = 0;
+        s.root_moves = b->moves;
+        s.best_col = -1;
+
+        mid(&s, PNS_INF, PNS_INF, &res.phi, &res.delta);
+
+        res.nodes = s.nodes;
+        if (res.phi == 0) {
+            res.result = PNS_PROVEN;
+            res.best_col = s.best_col;   /* The reply whose delta reached 0 */
+        }
+        else if (res.delta == 0) {
+            res.result = PNS_DISPROVEN;
+        }
+    }
+
+    res.ms = time_now_ms() - start;
+    if (out) *out = res;
+    return res.result;
+}
+
+/*=======*/
@@ -0,0 +1,68 @@
+#ifndef GAME_PNS_H
+#define GAME_PNS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Game_board.h"
+
+
+// ===== Proof-number search ======
+//
+// Depth-first proof-number search (df-pn) answers one yes/no question: can
+// the side to move (the attacker) force a win? Every node keeps
+//    phi    proof number for the side to move there (cells it still has to win)
+//    delta  the same for the opponent
+// A node's phi is the smallest delta among its replies and its delta is the
+// sum of their phis. The search always walks into the reply with the
+// smallest delta and only comes back up when that reply's numbers pass
+// thresholds derived from its siblings (with the 1 + 1/4 trick, so it does
+// not bounce between two siblings of almost equal cost). Work goes where a
+// proof looks cheapest, not where the depth limit says.
+//
+// A draw counts as a loss for the attacker, so "disproved" means the side
+// to move cannot force a win (draw or loss). Only moves that do not hand
+// the opponent an immediate win are generated (board_safe_moves).
+//
+// Memory is a fixed table of 4-entry buckets. A full bucket drops the
+// entry with the least work below it, so a long proof keeps running in
+// bounded memory and only loses some of its cheapest subtrees.
+
+#define PNS_DEFAULT_MB      16          // Table size of the EXPERT AI prover
+#define PNS_MAX_MB          4096
+#define PNS_INF             0x7FFFFFFFu // Proof number of a lost (or drawn) node
+#define PNS_BUCKET_SIZE     4
+
+// ------ Results ----
+#define PNS_UNKNOWN         0           // Node or time budget ran out first
+#define PNS_PROVEN          1           // The side to move forces a win
+#define PNS_DISPROVEN       2           // It cannot: best play draws or loses
+
+typedef struct {
+    int result;             // PNS_UNKNOWN / PNS_PROVEN / PNS_DISPROVEN
+    int best_col;           // Winning move when proven (-1 otherwise)
+    uint32_t phi;           // Root proof number (0 - proven)
+    uint32_t delta;         // Root disproof number (0 - disproven)
+    uint64_t nodes;         // Nodes expanded
+    double ms;              // Wall-clock time spent
+} pns_result_t;
+
+typedef struct pns_s pns_t;
+
+/*=======*/
+
+
+// ===== Proof-number search functions ======
+
+// ------ Lifetime ----
+pns_t* pns_create(size_t mb);       // { mb - table size in MB (1..PNS_MAX_MB) } NULL on failure
+void   pns_destroy(pns_t* pns);     // Frees the table (NULL is ignored)
+void   pns_clear(pns_t* pns);       // Forgets every entry
+
+// ------ Proof ----
+int pns_prove(pns_t* pns, const board_t* b, uint64_t max_nodes, int time_ms,
+              pns_result_t* out);   // { max_nodes - expansion budget, time_ms - wall-clock budget (0 - none), out - stats (can be NULL) } PNS_* result
+
+/*=======*/
+
+
+#endif /* GAME_PNS_H */
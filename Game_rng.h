@@ -0,0 +1,75 @@
+#ifndef GAME_RNG_H
+#define GAME_RNG_H
+
+#include <stdint.h>
+
+
+// ===== Random numbers ======
+//
+// xoshiro256** with its 256-bit state filled from the seed by SplitMix64.
+// Every game / thread owns a generator: equal seeds replay equal games,
+// and no two threads ever share state. Header-only so random playouts
+// inline the few shifts and multiplies it costs.
+
+typedef struct {
+    uint64_t s[4];          // Generator state (one per thread / game, never shared)
+} rng_t;
+
+/*=======*/
+
+
+// ===== Generator functions ======
+
+// ------ Seeding ----
+static inline void rng_seed(rng_t* rng, uint64_t seed) {   // { seed - any value, 0 included }
+    // Expands the seed with SplitMix64, which never yields the all-zero state xoshiro cannot leave
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        rng->s[i] = z ^ (z >> 31);
+    }
+}
+
+// ------ Raw output ----
+static inline uint64_t rng_next(rng_t* rng) {
+    // Next 64 random bits (xoshiro256**)
+    uint64_t* s = rng->s;
+    uint64_t x = s[1] * 5;
+    uint64_t r = ((x << 7) | (x >> 57)) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+    return r;
+}
+
+// ------ Bounded output ----
+static inline int rng_below(rng_t* rng, int n) {   // { n - 1 .. 2^31 - 1 }
+    // Uniform value in [0, n) from the high 32 bits with one multiply (no division, bias below 2^-32 * n)
+    return (int)(((rng_next(rng) >> 32) * (uint64_t)n) >> 32);
+}
+
+static inline int rng_pick(rng_t* rng, unsigned mask) {   // { mask - candidate bits (0 - none) }
+    // Index of a uniformly chosen set bit of mask, or -1. One random draw, no retries.
+    // Callers that usually have every bit set can first draw over all bits and only fall
+    // back to this on a miss: the two steps together still pick uniformly.
+    int bits[32];
+    int n = 0;
+
+    /* Shifts one bit per step: mask >> 32 would be undefined when bit 31 is set */
+    for (int i = 0; mask; i++, mask >>= 1) {
+        bits[n] = i;                    /* Branch-free: the slot is only kept when bit i is set */
+        n += (int)(mask & 1u);
+    }
+    return (n) ? (bits[rng_below(rng, n)]) : (-1);
+}
+
+/*=======*/
+
+
+#endif /* GAME_RNG_H */
@@ -0,0 +1,339 @@
+#ifndef _WIN32
+#define _DEFAULT_SOURCE     // _SC_NPROCESSORS_ONLN under strict -std=c11
+#endif
+
+#include <stdatomic.h>
+#include <threads.h>
+#include "Game_search.h"
+#include "Game_time.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+
+// ===== Search state ======
+
+// ------ Per-thread state ----
+typedef struct {
+    tt_t* tt;               // Shared transposition table (NULL - none)
+    double deadline;        // time_now_ms() value to stop at (0 - no limit)
+    atomic_int* abort;      // Raised by the main worker when the whole search ends (Lazy SMP)
+    atomic_int* stop_ext;   // Raised by the caller's thread (NULL - none)
+    int stop;               // Latched once the deadline passed or abort was raised; every node then unwinds
+    int id;                 // Worker index (0 - main worker)
+    uint64_t nodes;         // Nodes visited so far
+    uint64_t tt_probes;     // Table lookups
+    uint64_t tt_hits;       // Table hits
+} search_t;
+
+// ------ Lazy SMP worker ----
+typedef struct {
+    search_t s;             // Worker search state
+    board_t root;           // Private copy of the root, moves are made and unmade on it
+    int max_depth;          // Deepest iteration allowed
+    int time_ms;            // Budget (only the main worker watches the clock)
+    double start;           // time_now_ms() at search start
+    int hint_col;           // Column tried first before any iteration completed (-1 none)
+    int best_col;           // Best column of the last completed iteration
+    int best;               // Its score
+    int done_depth;         // Last completed iteration
+} search_worker_t;
+
+
+// ------ Move ordering ----
+static int move_order[COLS];   // Columns sorted center-first (3, 2, 4, 1, 5, 0, 6 on a 7-wide board)
+static once_flag move_order_once = ONCE_FLAG_INIT;   // Searches start concurrently (self-play workers, pondering)
+
+static void init_move_order(void) {
+    // Fills move_order once with the columns sorted by distance to the center
+    for (int i = 0; i < COLS; i++) {
+        move_order[i] = COLS / 2 + ((i % 2) ? (i + 1) / 2 : -(i + 1) / 2);
+    }
+}
+
+// ------ Win scores in the table ----
+static int score_to_tt(int score, int ply) {   // { ply - distance from root }
+    // Win scores count plies from the root; the table keeps them relative to the node
+    if (score >= SEARCH_WIN_MIN) return score + ply;
+    if (score <= -SEARCH_WIN_MIN) return score - ply;
+    return score;
+}
+
+static int score_from_tt(int score, int ply) {   // { ply - distance from root }
+    // Converts a node-relative table score back to root distance
+    if (score >= SEARCH_WIN_MIN) return score - ply;
+    if (score <= -SEARCH_WIN_MIN) return score + ply;
+    return score;
+}
+
+/*=======*/
+
+
+// ===== Negamax ======
+
+// ------ Time control ----
+#define SEARCH_CHECK_NODES  1023   // Clock is read once every 1024 nodes
+
+static int out_of_time(search_t* s) {
+    // Returns 1 (and latches stop) once the deadline has passed or another worker ended the search
+    if (!s->stop && (s->nodes & SEARCH_CHECK_NODES) == 0) {
+        if (s->abort && atomic_load_explicit(s->abort, memory_order_relaxed))       s->stop = 1;
+        else if (s->stop_ext && atomic_load_explicit(s->stop_ext, memory_order_relaxed)) s->stop = 1;
+        else if (s->deadline > 0 && time_now_ms() >= s->deadline)                  s->stop = 1;
+    }
+    return s->stop;
+}
+
+// ------ Immediate win probe ----
+static int can_win_now(const board_t* b, int player) {   // { b - position, player - side to move }
+    // Returns 1 if player has a column that completes four in a row (one threat mask, no trial drops)
+    return board_winning_moves(b, player) != 0;
+}
+
+// ------ Alpha-beta ----
+static int negamax(search_t* s, board_t* b, int depth, int alpha, int beta, int ply) {   // { depth - plies left, ply - distance from root }
+    // Returns the score of b for the side to move, searched to depth plies with alpha-beta pruning.
+    // Children are made and unmade on b in O(1); b is unchanged on return.
+
+    int player = board_player_to_move(b);
+    int alpha_orig = alpha;
+    int tt_move = TT_NO_MOVE;
+    int mirrored = 0;
+    uint64_t key = 0;
+
+    s->nodes++;
+    if (out_of_time(s)) return 0;
+
+    /* Wins are found one ply early, so children never start on a won board */
+    if (can_win_now(b, player)) return SEARCH_WIN - (ply + 1);
+    if (b->moves >= BOARD_CELLS - 1) return 0;
+
+    /* Moves that hand the opponent a win are dropped up front; none left means a loss next ply */
+    bitboard_t safe = board_safe_moves(b);
+    if (!safe) return -(SEARCH_WIN - (ply + 2));
+    if (depth == 0) return 0;
+
+    /* Nothing better than winning right after the opponent's reply */
+    int max = SEARCH_WIN - (ply + 2);
+    if (beta > max) {
+        beta = max;
+        if (alpha >= beta) return beta;
+    }
+
+    if (s->tt) {
+        tt_data_t e;
+
+        /* Mirror images share one entry; its move is stored for the canonical orientation */
+        key = board_canonical_key(b, &mirrored);
+        s->tt_probes++;
+        if (tt_probe(s->tt, key, &e)) {
+            s->tt_hits++;
+            tt_move = (e.move < COLS) ? board_mirror_col(e.move, mirrored) : TT_NO_MOVE;
+
+            if (e.depth >= depth) {
+                int score = score_from_tt(e.score, ply);
+
+                if (e.bound == TT_EXACT) return score;
+                if (e.bound == TT_LOWER && score > alpha) alpha = score;
+                if (e.bound == TT_UPPER && score < beta) beta = score;
+                if (alpha >= beta) return score;
+            }
+        }
+    }
+
+    int best = -SEARCH_INF;
+    int best_col = TT_NO_MOVE;
+
+    /* Table move first, then center-first */
+    for (int i = -1; i < COLS; i++) {
+        int c = (i < 0) ? tt_move : move_order[i];
+        if (c == TT_NO_MOVE || (i >= 0 && c == tt_move)) continue;
+        if (!(safe & bitboard_column(c))) continue;
+
+        board_drop(b, c, player);
+        int score = -negamax(s, b, depth - 1, -beta, -alpha, ply + 1);
+        board_undo(b, c);
+
+        if (s->stop) return 0;      /* Aborted subtree: nothing trustworthy to store */
+
+        if (score > best) {
+            best = score;
+            best_col = c;
+        }
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) break;
+    }
+
+    if (s->tt) {
+        int bound = (best <= alpha_orig) ? TT_UPPER : (best >= beta) ? TT_LOWER : TT_EXACT;
+        tt_store(s->tt, key, score_to_tt(best, ply), (best_col < COLS) ? board_mirror_col(best_col, mirrored) : best_col, depth, bound);
+    }
+
+    return best;
+}
+
+/*=======*/
+
+
+// ===== Search entry point ======
+
+// ------ Root search ----
+static int root_search(search_t* s, board_t* b, int depth, int first_col, int* best_col) {   // { depth - plies, first_col - column to try first (-1 none), best_col - out }
+    // Searches every root move to depth plies. Returns the best score; *best_col gets its column (center-first on ties).
+    // Helper workers rotate the root order so they fill the table with different subtrees first.
+
+    int player = board_player_to_move(b);
+    int best = -SEARCH_INF;
+
+    *best_col = -1;
+
+    for (int i = -1; i < COLS; i++) {
+        int c = (i < 0) ? first_col : move_order[(i + s->id) % COLS];
+        if (c < 0 || (i >= 0 && c == first_col)) continue;
+        if (!board_can_play(b, c)) continue;
+
+        board_drop(b, c, player);
+        s->nodes++;
+
+        int score;
+        if (board_has_won(b, player))   score = SEARCH_WIN - 1;
+        else if (board_is_full(b))      score = 0;
+        else                            score = -negamax(s, b, depth - 1, -SEARCH_INF, -best, 1);
+        board_undo(b, c);
+
+        if (s->stop) break;
+
+        if (score > best) {
+            best = score;
+            *best_col = c;
+        }
+    }
+
+    return best;
+}
+
+// ------ Iterative deepening ----
+static int iterate(void* arg) {   // { arg - search_worker_t }
+    // Deepens one ply at a time until max_depth, a proven result, the deadline or an abort.
+    // Odd helpers start one ply deeper so the workers do not all march in lockstep.
+
+    search_worker_t* w = (search_worker_t*)arg;
+    int first = 1 + (w->s.id & 1);
+
+    for (int depth = first; depth <= w->max_depth; depth++) {
+        int col;
+        int score = root_search(&w->s, &w->root, depth, (w->best_col >= 0) ? (w->best_col) : (w->hint_col), &col);
+
+        if (w->s.stop) break;
+
+        w->best_col = col;
+        w->best = score;
+        w->done_depth = depth;
+
+        /* Forced results do not change with more depth */
+        if (score >= SEARCH_WIN_MIN || score <= -SEARCH_WIN_MIN) break;
+
+        /* The first iteration always completes, so there is a move to return even on a tiny budget */
+        if (w->s.id == 0 && w->time_ms > 0) w->s.deadline = w->start + w->time_ms;
+    }
+
+    return 0;
+}
+
+// ------ Best move ----
+int search_best_move(const board_t* b, const search_params_t* params, tt_t* tt, search_result_t* out) {   // { b - position, params - limits, tt - table (can be NULL), out - stats (can be NULL) }
+    // Runs params->threads Lazy SMP workers over the shared table; worker 0 owns the clock.
+    // Returns the best column of the deepest completed iteration, or -1 if the board is full.
+
+    search_worker_t workers[SEARCH_MAX_THREADS];
+    thrd_t handles[SEARCH_MAX_THREADS];
+    atomic_int abort_flag;
+    double start = time_now_ms();
+    int threads = params->threads;
+    int max_depth = params->max_depth;
+    int spawned = 1;
+
+    call_once(&move_order_once, init_move_order);
+
+    if (max_depth > BOARD_CELLS - b->moves) max_depth = BOARD_CELLS - b->moves;
+    if (threads < 1) threads = 1;
+    if (threads > SEARCH_MAX_THREADS) threads = SEARCH_MAX_THREADS;
+    if (!tt) threads = 1;   /* Helpers only help through the table */
+
+    atomic_init(&abort_flag, 0);
+    if (tt) tt_new_search(tt);
+
+    for (int i = 0; i < threads; i++) {
+        search_worker_t* w = &workers[i];
+        search_t zero = { 0 };
+
+        w->s = zero;
+        w->s.tt = tt;
+        w->s.abort = &abort_flag;
+        w->s.stop_ext = params->stop;
+        w->s.id = i;
+        w->root = *b;
+        w->max_depth = max_depth;
+        w->time_ms = params->time_ms;
+        w->start = start;
+        w->hint_col = (params->root_hint > 0 && params->root_hint <= COLS) ? (params->root_hint - 1) : (-1);
+        w->best_col = -1;
+        w->best = 0;
+        w->done_depth = 0;
+    }
+
+    for (int i = 1; i < threads; i++) {
+        if (thrd_create(&handles[i], iterate, &workers[i]) != thrd_success) break;
+        spawned++;
+    }
+
+    iterate(&workers[0]);
+    atomic_store(&abort_flag, 1);
+
+    for (int i = 1; i < spawned; i++) thrd_join(handles[i], NULL);
+
+    /* Deepest completed iteration wins; the main worker on ties */
+    search_worker_t* pick = &workers[0];
+    for (int i = 1; i < spawned; i++) {
+        if (workers[i].done_depth > pick->done_depth && workers[i].best_col >= 0) pick = &workers[i];
+    }
+
+    if (out) {
+        out->best_col = pick->best_col;
+        out->score = pick->best;
+        out->depth = pick->done_depth;
+        out->threads = spawned;
+        out->from_book = 0;
+        out->from_pns = 0;
+        out->nodes = 0;
+        out->tt_probes = 0;
+        out->tt_hits = 0;
+        for (int i = 0; i < spawned; i++) {
+            out->nodes += workers[i].s.nodes;
+            out->tt_probes += workers[i].s.tt_probes;
+            out->tt_hits += workers[i].s.tt_hits;
+        }
+        out->ms = time_now_ms() - start;
+        out->pondered = 0;
+    }
+
+    return pick->best_col;
+}
+
+// ------ Hardware ----
+int search_cpu_count(void) {
+    // Returns the number of online logical processors (at least 1)
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (si.dwNumberOfProcessors > 0) ? (int)si.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+#endif
+}
+
+/*=======*/
@@ -0,0 +1,56 @@
+#ifndef GAME_SEARCH_H
+#define GAME_SEARCH_H
+
+#include <stdatomic.h>
+#include "Game_board.h"
+#include "Game_tt.h"
+
+
+// ===== Search constants ======
+
+#define SEARCH_DEFAULT_DEPTH  14        // Plies searched when no time budget is given
+#define SEARCH_MAX_DEPTH      BOARD_CELLS // Depth limit for time-budgeted searches
+#define SEARCH_WIN            1000      // Score of a win on the next move (minus the ply it happens on)
+#define SEARCH_WIN_MIN        (SEARCH_WIN - BOARD_CELLS - 1)   // Scores beyond this are forced wins
+#define SEARCH_INF            30000
+#define SEARCH_MAX_THREADS    256       // Lazy SMP worker limit
+
+/*=======*/
+
+
+// ===== Search types ======
+
+typedef struct {
+    int max_depth;          // Deepest iteration (capped at the empty cells)
+    int time_ms;            // Wall-clock budget (0 - no limit)
+    int threads;            // Lazy SMP workers sharing the table (1 - single threaded)
+    atomic_int* stop;       // Ends the search early when another thread sets it (NULL - none; pondering)
+    int root_hint;          // Column + 1 to search first in the first iteration, e.g. a book estimate (0 - none)
+} search_params_t;
+
+typedef struct {
+    int best_col;           // Best column found (-1 if the board is full)
+    int score;              // Score from the side to move's point of view
+    int depth;              // Last completed iteration (plies)
+    int threads;            // Workers that took part
+    int from_book;          // 1 - move came from the opening book, no search ran
+    uint64_t nodes;         // Nodes visited (all workers)
+    uint64_t tt_probes;     // Transposition table lookups
+    uint64_t tt_hits;       // Lookups that found the position
+    double ms;              // Wall-clock time spent
+    int pondered;           // 1 - answered by a ponder search that guessed the opponent's move
+    int from_pns;           // 1 - move came from a df-pn proof of a forced win, no search ran
+} search_result_t;
+
+/*=======*/
+
+
+// ===== Search functions ======
+
+int search_best_move(const board_t* b, const search_params_t* params, tt_t* tt, search_result_t* out);   // { b - position, params - limits, tt - table (can be NULL), out - stats (can be NULL) }
+int search_cpu_count(void);                                                                              // Online logical processors
+
+/*=======*/
+
+
+#endif /* GAME_SEARCH_H */
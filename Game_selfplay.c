@@ -0,0 +1,342 @@
+/*
+    Game_selfplay.c - Headless AI vs AI harness
+    -------------------------------------------
+    Plays N games between two AI configurations on a pool of threads and
+    reports throughput, results and per-move latency.
+
+    Usage:
+      selfplay <ai_a> <ai_b> [games] [threads] [seed] [random_plies] [hash_mb]
+      (defaults: 1000 games, all CPUs, seed 1, 2 random opening plies, 4 MB table per thread)
+
+    AI configurations:
+      easy          random column
+      center        win now / block / center (the former hard)
+      hard          win now / endgame database / block / evaluated 6-ply look-ahead
+                    (connect4.egdb from Game_egdb_gen, if present)
+      expert:<ms>   iterative deepening search, <ms> per move
+      pns:<ms>      expert, but a df-pn forced-win proof (AI_PNS_NODES) runs first
+      depth:<n>     search to a fixed depth of <n> plies (deterministic, fast)
+      mcts:<ms>     Monte Carlo tree search, <ms> per move (one thread per game)
+
+    Sides alternate every game. Every game gets its own seed derived from
+    (seed, game index), so a run is reproducible whatever the thread count.
+
+    Build (MinGW / gcc):
+      gcc -O2 Game_selfplay.c Game_ai.c Game_board.c Game_book.c Game_egdb.c Game_eval.c Game_mcts.c Game_pns.c Game_search.c Game_tt.c Game_time.c -o selfplay -pthread -lm
+*/
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include "Game_ai.h"
+#include "Game_time.h"
+
+
+// ===== Configuration ======
+
+#define AI_KIND_EASY    0
+#define AI_KIND_HARD    1
+#define AI_KIND_EXPERT  2   // Time budget
+#define AI_KIND_DEPTH   3   // Fixed depth
+#define AI_KIND_MCTS    4   // Time budget, Monte Carlo tree search
+#define AI_KIND_CENTER  5   // Win / block / center heuristic
+#define AI_KIND_PNS     6   // Time budget, df-pn proof first
+
+#define SELFPLAY_MCTS_NODES (1u << 20)   // Arena per worker
+#define SELFPLAY_PNS_MB     4           // df-pn table per worker
+
+typedef struct {
+    const char* name;       // As given on the command line
+    int kind;               // AI_KIND_*
+    int arg;                // ms for expert, plies for depth
+} ai_config_t;
+
+static int parse_ai(const char* s, ai_config_t* ai) {   // { s - "easy" / "hard" / "expert:<ms>" / "depth:<n>", ai - out }
+    // Parses one AI configuration. Returns 0 on unknown syntax.
+    ai->name = s;
+    ai->arg = 0;
+
+    if (!strcmp(s, "easy")) { ai->kind = AI_KIND_EASY; return 1; }
+    if (!strcmp(s, "hard")) { ai->kind = AI_KIND_HARD; return 1; }
+    if (!strcmp(s, "center")) { ai->kind = AI_KIND_CENTER; return 1; }
+
+    if (!strncmp(s, "expert:", 7)) { ai->kind = AI_KIND_EXPERT; ai->arg = atoi(s + 7); return ai->arg > 0; }
+    if (!strncmp(s, "depth:", 6))  { ai->kind = AI_KIND_DEPTH;  ai->arg = atoi(s + 6); return ai->arg > 0; }
+    if (!strncmp(s, "mcts:", 5))   { ai->kind = AI_KIND_MCTS;   ai->arg = atoi(s + 5); return ai->arg > 0; }
+    if (!strncmp(s, "pns:", 4))    { ai->kind = AI_KIND_PNS;    ai->arg = atoi(s + 4); return ai->arg > 0; }
+
+    return 0;
+}
+
+/*=======*/
+
+
+// ===== Shared run state ======
+
+typedef struct {
+    float* ms;              // Move latencies
+    size_t count;
+    size_t cap;
+} latency_t;
+
+typedef struct {
+    int id;                 // Worker index
+    tt_t* tt;               // Worker-private table (NULL - none)
+    mcts_t* mcts;           // Worker-private MCTS arena (NULL - none)
+    pns_t* pns;             // Worker-private df-pn table (NULL - none)
+    uint64_t mcts_sims;     // MCTS playouts and the time they took
+    double mcts_ms;
+    rng_t rng;              // Worker-private generator, reseeded per game
+    int wins, draws, losses;   // From ai_a's point of view
+    uint64_t plies;         // Total game length
+    latency_t lat[2];       // Per configuration (0 - ai_a, 1 - ai_b)
+} worker_t;
+
+static ai_config_t cfg[2];
+static egdb_t* egdb = NULL;                // Endgame database of the hard AI (NULL - none)
+static int total_games = 1000;
+static int random_plies = 2;
+static uint64_t base_seed = 1;
+static atomic_int next_game;
+
+static void latency_push(latency_t* l, float ms) {   // { l - sample list, ms - one move }
+    // Appends one sample; a failed grow just drops it
+    if (l->count == l->cap) {
+        size_t cap = (l->cap) ? (l->cap * 2) : (4096);
+        float* p = (float*)realloc(l->ms, cap * sizeof(*p));
+        if (!p) return;
+        l->ms = p;
+        l->cap = cap;
+    }
+    l->ms[l->count++] = ms;
+}
+
+/*=======*/
+
+
+// ===== Game loop ======
+
+// ------ One move ----
+static int choose(worker_t* w, int side, const board_t* b) {   // { side - 0 ai_a / 1 ai_b, b - position }
+    // Asks configuration `side` for a move
+    const ai_config_t* ai = &cfg[side];
+    search_result_t res;
+
+    switch (ai->kind) {
+    case AI_KIND_EASY:
+        return ai_choose_column(b, &w->rng);
+
+    case AI_KIND_HARD:
+        return ai_choose_column_hard(b, board_player_to_move(b), egdb);
+
+    case AI_KIND_CENTER:
+        return ai_choose_column_center(b, board_player_to_move(b));
+
+    case AI_KIND_EXPERT: {
+        search_params_t params = { SEARCH_MAX_DEPTH, ai->arg, 1, NULL, 0 };
+        return ai_choose_column_expert(b, &params, w->tt, NULL, NULL, &res);
+    }
+
+    case AI_KIND_PNS: {
+        search_params_t params = { SEARCH_MAX_DEPTH, ai->arg, 1, NULL, 0 };
+        return ai_choose_column_expert(b, &params, w->tt, NULL, w->pns, &res);
+    }
+
+    case AI_KIND_MCTS: {
+        mcts_params_t params = { ai->arg, 1, 0, rng_next(&w->rng) | 1 };   /* Playouts follow the game seed */
+        mcts_result_t mres;
+        int col = ai_choose_column_mcts(b, w->mcts, &params, &mres);
+        w->mcts_sims += mres.sims;
+        w->mcts_ms += mres.ms;
+        return col;
+    }
+
+    default: {
+        search_params_t params = { ai->arg, 0, 1, NULL, 0 };
+        return ai_choose_column_expert(b, &params, w->tt, NULL, NULL, &res);
+    }
+    }
+}
+
+// ------ One game ----
+static void play_one(worker_t* w, int game) {   // { game - index, decides sides and seed }
+    // Plays game `game` to the end and records its result and move latencies
+    board_t b;
+    int a_player = (game & 1) ? PLAYER_2 : PLAYER_1;   /* ai_a opens every even game */
+
+    rng_seed(&w->rng, base_seed * 0x9E3779B97F4A7C15ULL + (uint64_t)game);
+    board_reset(&b);
+    if (w->tt) tt_clear(w->tt);
+    if (w->pns) pns_clear(w->pns);
+
+    for (;;) {
+        int player = board_player_to_move(&b);
+        int side = (player == a_player) ? 0 : 1;
+        int col;
+
+        if (b.moves < random_plies) {
+            col = ai_choose_column(&b, &w->rng);
+        }
+        else {
+            double t0 = time_now_ms();
+            col = choose(w, side, &b);
+            latency_push(&w->lat[side], (float)(time_now_ms() - t0));
+        }
+
+        board_drop(&b, col, player);
+
+        if (board_has_won(&b, player)) {
+            if (side == 0) w->wins++;
+            else           w->losses++;
+            break;
+        }
+        if (board_is_full(&b)) {
+            w->draws++;
+            break;
+        }
+    }
+
+    w->plies += (uint64_t)b.moves;
+}
+
+// ------ Worker thread ----
+static int worker_main(void* arg) {   // { arg - worker_t }
+    // Pulls game indices until every game has been played
+    worker_t* w = (worker_t*)arg;
+
+    for (;;) {
+        int game = atomic_fetch_add(&next_game, 1);
+        if (game >= total_games) break;
+        play_one(w, game);
+    }
+    return 0;
+}
+
+/*=======*/
+
+
+// ===== Report ======
+
+static int cmp_float(const void* a, const void* b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static void print_latency(const char* name, latency_t* l) {   // { name - AI config, l - merged samples }
+    // Prints move latency percentiles in milliseconds
+    if (!l->count) {
+        printf("  %-14s no moves\n", name);
+        return;
+    }
+
+    qsort(l->ms, l->count, sizeof(*l->ms), cmp_float);
+
+    printf("  %-14s moves %8zu   p50 %8.3f   p90 %8.3f   p99 %8.3f   max %8.3f ms\n", name, l->count,
+        l->ms[l->count / 2], l->ms[l->count * 90 / 100], l->ms[l->count * 99 / 100], l->ms[l->count - 1]);
+}
+
+/*=======*/
+
+
+// ===== Main function ======
+
+int main(int argc, char** argv) {
+    int threads = search_cpu_count();
+    int hash_mb = 4;
+    worker_t* workers;
+    thrd_t* handles;
+    int started = 0;
+    double start, elapsed;
+    worker_t sum = { 0 };
+
+    if (argc < 3 || !parse_ai(argv[1], &cfg[0]) || !parse_ai(argv[2], &cfg[1])) {
+        printf("usage: %s <ai_a> <ai_b> [games] [threads] [seed] [random_plies] [hash_mb]\n", argv[0]);
+        printf("  ai: easy | center | hard | expert:<ms> | depth:<plies> | mcts:<ms> | pns:<ms>\n");
+        return 1;
+    }
+
+    if (argc > 3) total_games = atoi(argv[3]);
+    if (argc > 4) threads = atoi(argv[4]);
+    if (argc > 5) base_seed = strtoull(argv[5], NULL, 10);
+    if (argc > 6) random_plies = atoi(argv[6]);
+    if (argc > 7) hash_mb = atoi(argv[7]);
+    if (threads < 1) threads = 1;
+    if (random_plies < 0) random_plies = 0;
+
+    workers = (worker_t*)calloc((size_t)threads, sizeof(*workers));
+    handles = (thrd_t*)calloc((size_t)threads, sizeof(*handles));
+    if (!workers || !handles) return 1;
+
+    atomic_init(&next_game, 0);
+    egdb = egdb_open(EGDB_DEFAULT_PATH);   /* Optional: the hard AI searches without it */
+
+    for (int i = 0; i < threads; i++) {
+        workers[i].id = i;
+        if (cfg[0].kind == AI_KIND_EXPERT || cfg[1].kind == AI_KIND_EXPERT
+            || cfg[0].kind == AI_KIND_DEPTH || cfg[1].kind == AI_KIND_DEPTH
+            || cfg[0].kind == AI_KIND_PNS || cfg[1].kind == AI_KIND_PNS) {
+            workers[i].tt = tt_create((size_t)hash_mb, 0);
+        }
+        if (cfg[0].kind == AI_KIND_PNS || cfg[1].kind == AI_KIND_PNS) {
+            workers[i].pns = pns_create(SELFPLAY_PNS_MB);
+            if (!workers[i].pns) return 1;
+        }
+        if (cfg[0].kind == AI_KIND_MCTS || cfg[1].kind == AI_KIND_MCTS) {
+            workers[i].mcts = mcts_create(SELFPLAY_MCTS_NODES);
+            if (!workers[i].mcts) return 1;
+        }
+    }
+
+    // ------ Run ----
+    start = time_now_ms();
+    for (int i = 0; i < threads; i++) {
+        if (thrd_create(&handles[i], worker_main, &workers[i]) != thrd_success) break;
+        started++;
+    }
+    if (!started) worker_main(&workers[0]);
+    for (int i = 0; i < started; i++) thrd_join(handles[i], NULL);
+    elapsed = time_now_ms() - start;
+
+    // ------ Merge ----
+    for (int i = 0; i < threads; i++) {
+        sum.wins += workers[i].wins;
+        sum.draws += workers[i].draws;
+        sum.losses += workers[i].losses;
+        sum.plies += workers[i].plies;
+        sum.mcts_sims += workers[i].mcts_sims;
+        sum.mcts_ms += workers[i].mcts_ms;
+
+        for (int s = 0; s < 2; s++) {
+            for (size_t j = 0; j < workers[i].lat[s].count; j++) latency_push(&sum.lat[s], workers[i].lat[s].ms[j]);
+            free(workers[i].lat[s].ms);
+        }
+        tt_destroy(workers[i].tt);
+        mcts_destroy(workers[i].mcts);
+        pns_destroy(workers[i].pns);
+    }
+
+    printf("%s vs %s: %d games on %d threads, seed %llu, %d random plies\n",
+        cfg[0].name, cfg[1].name, total_games, threads, (unsigned long long)base_seed, random_plies);
+    printf("  games/sec      %.1f\n", (elapsed > 0) ? (total_games * 1000.0 / elapsed) : (0.0));
+    printf("  %s W/D/L    %d / %d / %d  (%.1f%% / %.1f%% / %.1f%%)\n", cfg[0].name, sum.wins, sum.draws, sum.losses,
+        100.0 * sum.wins / (total_games ? total_games : 1),
+        100.0 * sum.draws / (total_games ? total_games : 1),
+        100.0 * sum.losses / (total_games ? total_games : 1));
+    printf("  avg length     %.2f plies\n", (total_games) ? ((double)sum.plies / total_games) : (0.0));
+    if (sum.mcts_ms > 0) printf("  mcts sims/sec  %.0f per thread\n", sum.mcts_sims * 1000.0 / sum.mcts_ms);
+    printf("move latency:\n");
+    print_latency(cfg[0].name, &sum.lat[0]);
+    print_latency(cfg[1].name, &sum.lat[1]);
+
+    free(sum.lat[0].ms);
+    free(sum.lat[1].ms);
+    egdb_close(egdb);
+    free(workers);
+    free(handles);
+    return 0;
+}
+
+/*=======*/
@@ -0,0 +1,241 @@
+#include "Game_solve.h"
+#include "Game_time.h"
+
+
+// ===== Solver state ======
+
+typedef struct {
+    tt_t* tt;               // Table holding solver bounds only (NULL - none)
+    uint64_t nodes;         // Nodes visited
+} solver_t;
+
+/*=======*/
+
+
+// ===== Null-window negamax ======
+
+// ------ Move ordering ----
+static int threat_count(bitboard_t own, bitboard_t occupied) {   // { own - chips after the move, occupied - all chips after it }
+    // Empty cells that would complete four for own (bit count loop, no popcnt assumed)
+    bitboard_t t = bitboard_winning_cells(own, occupied);
+    int n = 0;
+
+    for (; t; t &= t - 1) n++;
+    return n;
+}
+
+static int order_moves(const solver_t* s, const board_t* b, bitboard_t moves, int first, int* cols) {   // { moves - landing cells, first - column to try first (-1 none), cols - out }
+    // Sorts the columns of moves by the threats they create, center-first on ties; first goes in front.
+    // The table buckets of the children start loading meanwhile (the probes are memory bound).
+    int player = board_player_to_move(b);
+    bitboard_t own = b->chips[player - 1];
+    bitboard_t occupied = b->chips[0] | b->chips[1];
+    int keys[COLS];
+    int n = 0;
+
+    for (int i = 0; i < COLS; i++) {
+        int c = COLS / 2 + ((i % 2) ? (i + 1) / 2 : -(i + 1) / 2);
+        bitboard_t move = moves & bitboard_column(c);
+        int key, j;
+
+        if (!move) continue;
+
+        if (s->tt) {
+            uint64_t child = ((player == PLAYER_1) ? (b->chips[0] | move) : (b->chips[0])) + (occupied | move);   /* board_key() after the move */
+            uint64_t mirror = board_mirror_key(child);
+            tt_prefetch(s->tt, (mirror < child) ? mirror : child);
+        }
+
+        key = (c == first) ? (COLS * ROWS) : threat_count(own | move, occupied | move);
+        for (j = n; j > 0 && keys[j - 1] < key; j--) {
+            keys[j] = keys[j - 1];
+            cols[j] = cols[j - 1];
+        }
+        keys[j] = key;
+        cols[j] = c;
+        n++;
+    }
+    return n;
+}
+
+// ------ Negamax ----
+static int negamax(solver_t* s, board_t* b, int alpha, int beta) {   // { alpha < beta - window }
+    // Fail-hard alpha-beta on exact scores. The side to move cannot win at once (the caller checked).
+    bitboard_t next = board_safe_moves(b);
+    int tt_move = -1;
+    int mirrored = 0;
+    uint64_t key = 0;
+    int cols[COLS];
+    int n, min, max;
+
+    s->nodes++;
+
+    if (!next) return -(BOARD_CELLS - b->moves) / 2;    /* Every move lets the opponent win next */
+    if (b->moves >= BOARD_CELLS - 2) return 0;          /* Two cells left and no threat: draw */
+
+    /* The opponent cannot win on its next move, nor we on this one */
+    min = -(BOARD_CELLS - 2 - b->moves) / 2;
+    max = (BOARD_CELLS - 1 - b->moves) / 2;
+
+    if (s->tt) {
+        tt_data_t e;
+
+        key = board_canonical_key(b, &mirrored);
+        if (tt_probe(s->tt, key, &e)) {
+            if (e.bound == TT_UPPER && e.score < max) max = e.score;
+            if (e.bound == TT_LOWER && e.score > min) min = e.score;
+            if (e.move < COLS) tt_move = board_mirror_col(e.move, mirrored);
+        }
+    }
+
+    if (alpha < min) {
+        alpha = min;
+        if (alpha >= beta) return alpha;
+    }
+    if (beta > max) {
+        beta = max;
+        if (alpha >= beta) return beta;
+    }
+
+    n = order_moves(s, b, next, tt_move, cols);
+
+    for (int i = 0; i < n; i++) {
+        int player = board_player_to_move(b);
+        int score;
+
+        board_drop(b, cols[i], player);
+        score = -negamax(s, b, -beta, -alpha);
+        board_undo(b, cols[i]);
+
+        if (score >= beta) {
+            /* Remaining cells bound the depth, so bigger subtrees win the replacement */
+            if (s->tt) tt_store(s->tt, key, score, board_mirror_col(cols[i], mirrored), BOARD_CELLS - b->moves, TT_LOWER);
+            return score;
+        }
+        if (score > alpha) alpha = score;
+    }
+
+    if (s->tt) tt_store(s->tt, key, alpha, TT_NO_MOVE, BOARD_CELLS - b->moves, TT_UPPER);
+    return alpha;
+}
+
+/*=======*/
+
+
+// ===== Driver ======
+
+// ------ Null-window narrowing ----
+static int solve_window(solver_t* s, board_t* b, int min, int max, int* tests) {   // { min/max - known bounds }
+    // Null-window tests at the middle of [min, max], pulled toward 0 where most
+    // scores lie, until the bounds meet (iterative narrowing in the MTD(f) family)
+    while (min < max) {
+        int med = min + (max - min) / 2;
+        int r;
+
+        if (med <= 0 && min / 2 < med)      med = min / 2;
+        else if (med >= 0 && max / 2 > med) med = max / 2;
+
+        r = negamax(s, b, med, med + 1);    /* Is the score above med? */
+        (*tests)++;
+
+        if (r <= med) max = r;
+        else          min = r;
+    }
+    return min;
+}
+
+static int solve_root(solver_t* s, board_t* b, int* tests) {
+    // Exact score of b (the game is not over)
+    if (board_winning_moves(b, board_player_to_move(b))) return (BOARD_CELLS + 1 - b->moves) / 2;
+    if (board_is_full(b)) return 0;
+
+    return solve_window(s, b, -(BOARD_CELLS - b->moves) / 2, (BOARD_CELLS + 1 - b->moves) / 2, tests);
+}
+
+// ------ Score only ----
+int solve_score(const board_t* b, tt_t* tt, solve_result_t* out) {   // { b - position, tt - solver table (can be NULL), out - stats (can be NULL) }
+    // Proves the exact value of b for the side to move
+    solver_t s = { tt, 0 };
+    board_t work = *b;
+    double start = time_now_ms();
+    int tests = 0;
+    int score = solve_root(&s, &work, &tests);
+
+    if (out) {
+        out->score = score;
+        out->best_col = -1;
+        out->plies = solve_plies_to_end(b, score);
+        out->tests = tests;
+        out->nodes = s.nodes;
+        out->ms = time_now_ms() - start;
+    }
+    return score;
+}
+
+// ------ Score and move ----
+int solve_best_move(const board_t* b, tt_t* tt, solve_result_t* out) {   // { b - position, tt - solver table (can be NULL), out - stats (can be NULL) }
+    // Proves the value of b, then one null-window test per move finds a column that keeps it
+    solver_t s = { tt, 0 };
+    board_t work = *b;
+    double start = time_now_ms();
+    int player = board_player_to_move(b);
+    int tests = 0;
+    int score = solve_root(&s, &work, &tests);
+    int best = -1;
+
+    if (board_winning_moves(b, player)) {
+        best = board_move_column(board_winning_moves(b, player));
+    }
+    else if (!board_is_full(b)) {
+        bitboard_t safe = board_safe_moves(b);
+        int cols[COLS];
+        int n = order_moves(&s, b, safe, -1, cols);
+
+        for (int i = 0; i < n && best < 0; i++) {
+            board_drop(&work, cols[i], player);
+            if (-negamax(&s, &work, -score, -score + 1) >= score) best = cols[i];   /* Child value <= -score */
+            board_undo(&work, cols[i]);
+            tests++;
+        }
+
+        /* Lost at once whatever we play: block a threat, or take any column */
+        if (best < 0) best = board_move_column(board_winning_moves(b, (player == PLAYER_1) ? PLAYER_2 : PLAYER_1));
+        if (best < 0) best = board_move_column(board_playable(b));
+    }
+
+    if (out) {
+        out->score = score;
+        out->best_col = best;
+        out->plies = solve_plies_to_end(b, score);
+        out->tests = tests;
+        out->nodes = s.nodes;
+        out->ms = time_now_ms() - start;
+    }
+    return score;
+}
+
+/*=======*/
+
+
+// ===== Score helpers ======
+
+int solve_plies_to_end(const board_t* b, int score) {   // { b - position, score - its exact score }
+    // The side to move owns moves / 2 chips and plays on plies 1, 3, 5 ... from here; the opponent on 2, 4, 6 ...
+    int chip;
+
+    if (score > 0) {
+        chip = SOLVE_MAX_SCORE + 1 - score;             /* Our winning chip */
+        return 2 * (chip - b->moves / 2) - 1;
+    }
+    if (score < 0) {
+        chip = SOLVE_MAX_SCORE + 1 + score;             /* The opponent's winning chip */
+        return 2 * (chip - (b->moves + 1) / 2);
+    }
+    return BOARD_CELLS - b->moves;
+}
+
+const char* solve_describe(int score) {   // { score - exact score }
+    return (score > 0) ? "win" : (score < 0) ? "loss" : "draw";
+}
+
+/*=======*/
@@ -0,0 +1,55 @@
+#ifndef GAME_SOLVE_H
+#define GAME_SOLVE_H
+
+#include <stdint.h>
+#include "Game_board.h"
+#include "Game_tt.h"
+
+
+// ===== Exact solver ======
+//
+// Proves the game-theoretic value of a position with perfect play from both
+// sides. Scores count how early the game ends:
+//    score > 0   the side to move wins with its chip number
+//                (BOARD_CELLS + 1) / 2 + 1 - score
+//    score = 0   draw
+//    score < 0   the opponent wins with its chip number
+//                (BOARD_CELLS + 1) / 2 + 1 + score
+// so faster wins score higher and every score fits in [-BOARD_CELLS / 2, BOARD_CELLS / 2].
+//
+// The driver never searches with a wide window. It runs null-window tests
+// (is the score above x?) and narrows [min, max] around a first guess of 0
+// until the bounds meet, MTD(f) style. Every test leaves bounds in the
+// transposition table for the next one. Inside a test, negamax plays only
+// moves that do not hand the opponent an immediate win (board_safe_moves),
+// tries moves that create the most threats first, and keys the table by
+// board_canonical_key() so mirror images share entries.
+
+#define SOLVE_MAX_SCORE     ((BOARD_CELLS + 1) / 2)     // Win with the first chip (never reachable from the empty board)
+
+typedef struct {
+    int score;              // Exact value for the side to move (see above)
+    int best_col;           // A move that keeps the score (-1 - not asked for or no move)
+    int plies;              // Plies until the game ends with perfect play (the whole board on a draw)
+    int tests;              // Null-window tests the driver ran
+    uint64_t nodes;         // Nodes visited
+    double ms;              // Wall-clock time spent
+} solve_result_t;
+
+/*=======*/
+
+
+// ===== Solver functions ======
+
+// ------ Solving ----
+int solve_score(const board_t* b, tt_t* tt, solve_result_t* out);        // { b - game not over, tt - table (can be NULL), out - stats (can be NULL) } Exact score
+int solve_best_move(const board_t* b, tt_t* tt, solve_result_t* out);    // Exact score, plus a column that keeps it in out->best_col
+
+// ------ Score helpers ----
+int solve_plies_to_end(const board_t* b, int score);                     // { score - exact score of b } Plies until the game is over
+const char* solve_describe(int score);                                   // "win" / "draw" / "loss" for the side to move
+
+/*=======*/
+
+
+#endif /* GAME_SOLVE_H */
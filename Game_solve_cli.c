@@ -0,0 +1,137 @@
+/*
+    Game_solve_cli.c - Exact solver front end (headless)
+    ----------------------------------------------------
+    Proves positions with Game_solve.c and reports their value, a move that
+    keeps it, and how fast the solver got there.
+
+    Usage:
+      solve <moves> [hash_mb]     One position given as 1-based columns ("" - empty board)
+      solve - [hash_mb]           One position per stdin line: "<moves> [expected_score]"
+      (default: 256 MB table)
+
+    In list mode every line gets its score and node count, and a summary
+    gives positions solved per second and nodes per position. Lines with an
+    expected score are checked against it. The table is kept from one
+    position to the next: solver bounds stay exact for any position.
+
+    Build (MinGW / gcc):
+      gcc -O2 Game_solve_cli.c Game_solve.c Game_board.c Game_tt.c Game_time.c -o solve
+
+    Build (MSVC):
+      cl /O2 /std:c11 /experimental:c11atomics Game_solve_cli.c Game_solve.c Game_board.c Game_tt.c Game_time.c
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Game_board.h"
+#include "Game_solve.h"
+#include "Game_tt.h"
+
+
+// ===== One position ======
+
+static int solve_one(const char* moves, tt_t* tt) {   // { moves - 1-based columns }
+    // Prints the value of the position and a move that keeps it
+    board_t b;
+    solve_result_t res;
+
+    if (!board_from_moves(&b, moves) || board_is_full(&b)) {
+        printf("Invalid or finished position: \"%s\"\n", moves);
+        return 1;
+    }
+
+    solve_best_move(&b, tt, &res);
+
+    printf("position   \"%s\" (%s to move)\n", moves, (board_player_to_move(&b) == PLAYER_1) ? "Player 1" : "Player 2");
+    if (res.score == 0) printf("value      draw (board fills up in %d plies)\n", res.plies);
+    else                printf("value      %s in %d plies (score %+d)\n", solve_describe(res.score), res.plies, res.score);
+    printf("best move  column %d\n", res.best_col + 1);
+    printf("search     %llu nodes, %d null-window tests, %.1f ms, %.2f Mnodes/s\n",
+        (unsigned long long)res.nodes, res.tests, res.ms, (res.ms > 0) ? ((double)res.nodes / res.ms / 1000.0) : (0.0));
+    return 0;
+}
+
+/*=======*/
+
+
+// ===== Position list ======
+
+static int solve_list(FILE* in, tt_t* tt) {   // { in - "<moves> [expected]" lines }
+    // Solves every line and prints throughput; returns 1 if a line had a different expected score
+    char line[256];
+    int count = 0, checked = 0, wrong = 0, skipped = 0;
+    uint64_t nodes = 0;
+    double ms = 0;
+
+    while (fgets(line, sizeof(line), in)) {
+        char moves[128];
+        int expected;
+        int fields = sscanf(line, "%127s %d", moves, &expected);
+        board_t b;
+        solve_result_t res;
+
+        if (fields < 1) continue;
+        if (!board_from_moves(&b, moves) || board_is_full(&b)) {
+            skipped++;
+            continue;
+        }
+
+        solve_score(&b, tt, &res);
+        count++;
+        nodes += res.nodes;
+        ms += res.ms;
+
+        printf("%-42s %+3d  %-4s %12llu nodes %10.3f ms", moves, res.score, solve_describe(res.score),
+            (unsigned long long)res.nodes, res.ms);
+        if (fields == 2) {
+            checked++;
+            if (res.score != expected) {
+                wrong++;
+                printf("  expected %+d", expected);
+            }
+        }
+        printf("\n");
+    }
+
+    printf("\n%d positions in %.1f ms", count, ms);
+    if (skipped) printf(" (%d invalid lines skipped)", skipped);
+    printf("\n");
+    if (count) {
+        printf("  positions/sec     %.1f\n", (ms > 0) ? (1000.0 * count / ms) : (0.0));
+        printf("  nodes/position    %.0f\n", (double)nodes / count);
+        printf("  Mnodes/s          %.2f\n", (ms > 0) ? ((double)nodes / ms / 1000.0) : (0.0));
+    }
+    if (checked) printf("  expected scores   %d / %d match\n", checked - wrong, checked);
+    return (wrong) ? (1) : (0);
+}
+
+/*=======*/
+
+
+// ===== Main function ======
+
+int main(int argc, char** argv) {
+    int hash_mb = (argc > 2) ? atoi(argv[2]) : 256;
+    tt_t* tt;
+    int rc;
+
+    if (argc < 2) {
+        printf("usage: %s <moves> [hash_mb]     solve one position (\"\" - empty board)\n", argv[0]);
+        printf("       %s - [hash_mb]           solve \"<moves> [expected_score]\" lines from stdin\n", argv[0]);
+        return 1;
+    }
+
+    tt = tt_create((size_t)hash_mb, 1);
+    if (!tt) {
+        printf("Could not allocate a %d MB transposition table.\n", hash_mb);
+        return 1;
+    }
+
+    rc = (!strcmp(argv[1], "-")) ? solve_list(stdin, tt) : solve_one(argv[1], tt);
+
+    tt_destroy(tt);
+    return rc;
+}
+
+/*=======*/
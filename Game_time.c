@@ -0,0 +1,93 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L     // clock_gettime / clock_nanosleep under strict -std=c11
+#endif
+
+#include "Game_time.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002   // Windows 10 1803+, missing from older headers
+#endif
+#else
+#include <errno.h>
+#include <time.h>
+#endif
+
+
+// ===== Monotonic clock ======
+
+double time_now_ms(void) {
+    // Reads the monotonic clock (QueryPerformanceCounter / CLOCK_MONOTONIC)
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+
+    return (double)now.QuadPart * 1000.0 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+#endif
+}
+
+/*=======*/
+
+
+// ===== Sleeping ======
+
+// ------ Absolute deadline ----
+void time_sleep_until_ms(double deadline) {   // { deadline - time_now_ms() value }
+    // Sleeps until the monotonic clock reaches deadline; returns at once if it already has
+#ifdef _WIN32
+    /* Sleep() rounds up to the 15.6 ms system tick, a high resolution timer does not */
+    HANDLE timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!timer) timer = CreateWaitableTimerW(NULL, TRUE, NULL);
+
+    for (;;) {
+        double left = deadline - time_now_ms();
+        LARGE_INTEGER due;
+
+        if (left <= 0) break;
+
+        if (!timer) {
+            Sleep((DWORD)left + 1);
+            continue;
+        }
+
+        due.QuadPart = -(LONGLONG)(left * 10000.0);   /* Relative, 100 ns units */
+        if (!SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE)) {
+            Sleep((DWORD)left + 1);
+            continue;
+        }
+        WaitForSingleObject(timer, INFINITE);
+    }
+
+    if (timer) CloseHandle(timer);
+#else
+    /* time_now_ms() reads CLOCK_MONOTONIC, so the deadline converts to an absolute timespec */
+    struct timespec ts;
+
+    if (deadline <= time_now_ms()) return;
+
+    ts.tv_sec = (time_t)(deadline / 1000.0);
+    ts.tv_nsec = (long)((deadline - (double)ts.tv_sec * 1000.0) * 1000000.0);
+    if (ts.tv_nsec >= 1000000000L) { ts.tv_sec++; ts.tv_nsec -= 1000000000L; }
+    if (ts.tv_nsec < 0) ts.tv_nsec = 0;
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+#endif
+}
+
+// ------ Relative delay ----
+void time_sleep_ms(double ms) {   // { ms - delay }
+    // Sleeps for ms milliseconds of monotonic time
+    time_sleep_until_ms(time_now_ms() + ms);
+}
+
+/*=======*/
@@ -0,0 +1,20 @@
+#ifndef GAME_TIME_H
+#define GAME_TIME_H
+
+
+// ===== Monotonic clock ======
+
+double time_now_ms(void);   // Milliseconds since an arbitrary start point, never jumps backwards
+
+/*=======*/
+
+
+// ===== Sleeping ======
+
+void time_sleep_until_ms(double deadline);   // { deadline - time_now_ms() value } Blocks the thread, no spinning
+void time_sleep_ms(double ms);               // { ms - relative delay }
+
+/*=======*/
+
+
+#endif /* GAME_TIME_H */
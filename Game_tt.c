@@ -0,0 +1,278 @@
+#ifndef _WIN32
+#define _DEFAULT_SOURCE     // MAP_ANONYMOUS / madvise under strict -std=c11
+#endif
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Game_tt.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define PREFETCH(p)     _mm_prefetch((const char*)(p), _MM_HINT_T0)
+#else
+#define PREFETCH(p)     __builtin_prefetch((p))
+#endif
+
+
+// ===== Table layout ======
+//
+// Each entry is 16 bytes: the packed data word and the key XOR-ed with it.
+// A probe only accepts an entry whose (key ^ data) matches, so a torn
+// write (key from one store, data from another) is simply a miss. That is
+// what lets Lazy SMP workers share the table without locks: both words are
+// relaxed atomics, which compile to plain 64-bit loads and stores.
+//
+// data bits:  0..15 score + 32768 | 16..23 move | 24..31 depth | 32..33 bound | 34..39 age
+
+typedef struct {
+    _Atomic uint64_t key_xor;   // Key ^ data
+    _Atomic uint64_t data;      // Packed score / move / depth / bound / age
+} tt_entry_t;
+
+#define LOAD(x)     atomic_load_explicit(&(x), memory_order_relaxed)
+#define STORE(x, v) atomic_store_explicit(&(x), (v), memory_order_relaxed)
+
+typedef struct {
+    tt_entry_t e[TT_BUCKET_SIZE];
+} tt_bucket_t;
+
+struct tt_s {
+    tt_bucket_t* buckets;   // Page aligned, so every bucket sits on one cache line
+    uint64_t count;         // Number of buckets (power of two)
+    int shift;              // 64 - log2(count), used by the multiplicative hash
+    size_t bytes;           // Allocated bytes
+    int huge;               // 1 if backed by large pages
+    unsigned age;           // Search generation (6 bits)
+};
+
+#define TT_AGE_MASK 63u
+
+/*=======*/
+
+
+// ===== Packing helpers ======
+
+static uint64_t pack(int score, int move, int depth, int bound, unsigned age) {
+    // Packs one entry into a 64-bit word
+    return (uint64_t)(uint16_t)(score + 32768)
+        | ((uint64_t)(move & 0xFF) << 16)
+        | ((uint64_t)(depth & 0xFF) << 24)
+        | ((uint64_t)(bound & 3) << 32)
+        | ((uint64_t)(age & TT_AGE_MASK) << 34);
+}
+
+static int data_bound(uint64_t d) { return (int)((d >> 32) & 3); }
+static int data_depth(uint64_t d) { return (int)((d >> 24) & 0xFF); }
+static unsigned data_age(uint64_t d) { return (unsigned)((d >> 34) & TT_AGE_MASK); }
+
+static tt_bucket_t* bucket_of(const tt_t* tt, uint64_t key) {
+    // Fibonacci hashing spreads the structured bitboard keys over the table
+    return &tt->buckets[(key * 0x9E3779B97F4A7C15ULL) >> tt->shift];
+}
+
+/*=======*/
+
+
+// ===== Memory ======
+
+// ------ Allocation ----
+static void* alloc_pages(size_t bytes, int huge_pages, int* got_huge) {   // { bytes - size, huge_pages - 1 try large pages }
+    // Allocates zeroed, page-aligned memory, trying large pages first when asked
+    void* p;
+
+    *got_huge = 0;
+
+#ifdef _WIN32
+    if (huge_pages) {
+        SIZE_T large = GetLargePageMinimum();
+        if (large && bytes % large == 0) {
+            p = VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (p) {
+                *got_huge = 1;
+                return p;
+            }
+        }
+    }
+    return VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+#ifdef MAP_HUGETLB
+    if (huge_pages) {
+        p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            *got_huge = 1;
+            return p;
+        }
+    }
+#endif
+    p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return NULL;
+#ifdef MADV_HUGEPAGE
+    /* No reserved huge pages: let transparent huge pages back the table instead */
+    if (huge_pages) madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+    return p;
+#endif
+}
+
+static void free_pages(void* p, size_t bytes) {
+    // Releases memory from alloc_pages
+#ifdef _WIN32
+    (void)bytes;
+    VirtualFree(p, 0, MEM_RELEASE);
+#else
+    munmap(p, bytes);
+#endif
+}
+
+/*=======*/
+
+
+// ===== Lifetime ======
+
+tt_t* tt_create(size_t mb, int huge_pages) {   // { mb - size in MB, huge_pages - 1 try large pages }
+    // Allocates the largest power-of-two bucket count that fits in mb megabytes
+    tt_t* tt;
+    uint64_t count = 1;
+    int bits = 0;
+
+    if (mb < TT_MIN_MB) mb = TT_MIN_MB;
+    if (mb > TT_MAX_MB) mb = TT_MAX_MB;
+
+    while ((count << 1) * sizeof(tt_bucket_t) <= (uint64_t)mb << 20) {
+        count <<= 1;
+        bits++;
+    }
+
+    tt = (tt_t*)calloc(1, sizeof(*tt));
+    if (!tt) return NULL;
+
+    tt->count = count;
+    tt->shift = 64 - bits;
+    tt->bytes = (size_t)(count * sizeof(tt_bucket_t));
+    tt->buckets = (tt_bucket_t*)alloc_pages(tt->bytes, huge_pages, &tt->huge);
+
+    if (!tt->buckets) {
+        free(tt);
+        return NULL;
+    }
+
+    /* Touch every page now so the first search does not pay the page faults */
+    tt_clear(tt);
+
+    return tt;
+}
+
+void tt_destroy(tt_t* tt) {
+    // Frees the table and its pages
+    if (!tt) return;
+    free_pages(tt->buckets, tt->bytes);
+    free(tt);
+}
+
+void tt_clear(tt_t* tt) {
+    // Empties every bucket and restarts the generation counter
+    memset(tt->buckets, 0, tt->bytes);
+    tt->age = 0;
+}
+
+void tt_new_search(tt_t* tt) {
+    // Entries from earlier searches become preferred replacement victims
+    tt->age = (tt->age + 1) & TT_AGE_MASK;
+}
+
+/*=======*/
+
+
+// ===== Access ======
+
+// ------ Probe ----
+int tt_probe(const tt_t* tt, uint64_t key, tt_data_t* out) {   // { key - position key, out - entry data on hit }
+    // Looks key up in its bucket. Returns 1 on hit.
+    const tt_bucket_t* b = bucket_of(tt, key);
+
+    for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+        uint64_t d = LOAD(b->e[i].data);
+        uint64_t k = LOAD(b->e[i].key_xor) ^ d;
+
+        if (k == key && data_bound(d) != TT_NONE) {
+            out->score = (int)(d & 0xFFFF) - 32768;
+            out->move = (int)((d >> 16) & 0xFF);
+            out->depth = data_depth(d);
+            out->bound = data_bound(d);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ------ Store ----
+void tt_store(tt_t* tt, uint64_t key, int score, int move, int depth, int bound) {   // { depth - remaining depth, bound - TT_* }
+    // Replaces the same key if present, else an empty slot, else the shallowest / oldest entry
+    tt_bucket_t* b = bucket_of(tt, key);
+    tt_entry_t* victim = &b->e[0];
+    int worst = 1 << 30;
+
+    for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+        tt_entry_t* e = &b->e[i];
+        uint64_t d = LOAD(e->data);
+
+        if (data_bound(d) == TT_NONE || (LOAD(e->key_xor) ^ d) == key) {
+            victim = e;
+            break;
+        }
+
+        /* Every generation of age costs as much as 4 plies of depth */
+        int value = data_depth(d) - 4 * (int)((tt->age - data_age(d)) & TT_AGE_MASK);
+        if (value < worst) {
+            worst = value;
+            victim = e;
+        }
+    }
+
+    uint64_t data = pack(score, move, depth, bound, tt->age);
+    STORE(victim->data, data);
+    STORE(victim->key_xor, key ^ data);
+}
+
+// ------ Prefetch ----
+void tt_prefetch(const tt_t* tt, uint64_t key) {   // { key - position about to be probed }
+    // A bucket is one cache line: one prefetch brings in the whole bucket
+    PREFETCH(bucket_of(tt, key));
+}
+
+/*=======*/
+
+
+// ===== Info ======
+
+size_t tt_size_mb(const tt_t* tt) {
+    return tt->bytes >> 20;
+}
+
+int tt_uses_huge_pages(const tt_t* tt) {
+    return tt->huge;
+}
+
+int tt_usage_permille(const tt_t* tt) {
+    // Samples up to 1000 buckets and counts entries written by the current generation
+    uint64_t n = (tt->count < 1000) ? tt->count : 1000;
+    uint64_t used = 0;
+
+    for (uint64_t i = 0; i < n; i++) {
+        for (int j = 0; j < TT_BUCKET_SIZE; j++) {
+            uint64_t d = LOAD(tt->buckets[i].e[j].data);
+            if (data_bound(d) != TT_NONE && data_age(d) == tt->age) used++;
+        }
+    }
+
+    return (int)(used * 1000 / (n * TT_BUCKET_SIZE));
+}
+
+/*=======*/
@@ -0,0 +1,62 @@
+#ifndef GAME_TT_H
+#define GAME_TT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+// ===== Transposition table constants ======
+
+#define TT_DEFAULT_MB   64          // Table size used when nothing is set at startup
+#define TT_MIN_MB       1
+#define TT_MAX_MB       4096
+
+#define TT_BUCKET_SIZE  4           // Entries per 64-byte bucket (one cache line)
+
+// ------ Bound types ----
+#define TT_NONE         0
+#define TT_UPPER        1           // Score is an upper bound (search failed low)
+#define TT_LOWER        2           // Score is a lower bound (search failed high)
+#define TT_EXACT        3
+
+#define TT_NO_MOVE      0xFF
+
+/*=======*/
+
+
+// ===== Transposition table types ======
+
+typedef struct {
+    int score;              // Stored score (node relative)
+    int move;               // Best column, or TT_NO_MOVE
+    int depth;              // Remaining depth the score was searched with
+    int bound;              // TT_UPPER / TT_LOWER / TT_EXACT
+} tt_data_t;
+
+typedef struct tt_s tt_t;
+
+/*=======*/
+
+
+// ===== Transposition table functions ======
+
+// ------ Lifetime ----
+tt_t* tt_create(size_t mb, int huge_pages);    // { mb - size in MB (clamped to TT_MIN_MB..TT_MAX_MB), huge_pages - 1 try large pages } NULL on failure
+void  tt_destroy(tt_t* tt);                    // Frees the table (NULL is ignored)
+void  tt_clear(tt_t* tt);                      // Empties every bucket
+void  tt_new_search(tt_t* tt);                 // Ages the table so older entries get replaced first
+
+// ------ Access ----
+int   tt_probe(const tt_t* tt, uint64_t key, tt_data_t* out);                          // { key - board_canonical_key() } 1 on hit
+void  tt_store(tt_t* tt, uint64_t key, int score, int move, int depth, int bound);     // Depth/age replacement inside the bucket
+void  tt_prefetch(const tt_t* tt, uint64_t key);                                       // Starts loading key's bucket so a later probe hits the cache
+
+// ------ Info ----
+size_t tt_size_mb(const tt_t* tt);             // Allocated size in MB
+int    tt_uses_huge_pages(const tt_t* tt);     // 1 if the table is backed by large pages
+int    tt_usage_permille(const tt_t* tt);      // Filled entries of this search generation, sampled on the first 1000 buckets
+
+/*=======*/
+
+
+#endif /* GAME_TT_H */
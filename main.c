@@ -1,18 +1,18 @@
 /*
-    main.c - Minimal Connect 4 (Console, Windows)
+    main.c - Minimal Connect 4 (Console, Windows / POSIX terminals)
     ---------------------------------------------
     Requirements met:
-    - Simple menu: PvP, AI Easy, AI Hard, Score, Exit
+    - Simple menu: PvP, AI Easy, AI Hard, AI Expert, Score, Exit
     - Simple ASCII graphics (no ANSI, no animations)
     - Reset option during a game: press R
     - Quit to menu during a game: press Q
-    - system("cls") used for clearing the screen
+    - system("cls") used for clearing the screen ("clear" on POSIX)
     - switch statements used for mode selection and actions
-    - No structs (scores are plain ints)
+    - Scores are plain ints; the board is the shared bitboard board_t (Game_board.h)
 
     Controls:
     Menu:
-      - Press 1..5
+      - Press 1..6
 
     In game:
       - Press 1..7 to drop in a column
@@ -20,37 +20,47 @@
       - Press Q to quit to menu
 
     Build (MSVC):
-      cl main.c
+      cl main.c Game_board.c Game_keyboard.c Game_search.c Game_tt.c Game_time.c
 
     Build (MinGW):
-      gcc main.c -o connect4.exe
+      gcc main.c Game_board.c Game_keyboard.c Game_search.c Game_tt.c Game_time.c -o connect4.exe -pthread
+
+    Build (Linux / macOS, termios keyboard):
+      gcc main.c Game_board.c Game_keyboard.c Game_search.c Game_tt.c Game_time.c -o connect4 -pthread
 */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <conio.h>   /* _getch() */
 #include "Config.h"
+#include "Game_board.h"
+#include "Game_keyboard.h"   /* kbd_read(): conio or termios, picked at build time */
+#include "Game_rng.h"        /* rng_pick(): per-game xoshiro256** generator */
+#include "Game_search.h"
 
 /* ------------------------- UI Helpers ------------------------- */
 
 /*
     clear_screen:
-    Clears the console using system("cls").
-    Windows-only but simple and matches your requirement.
+    Clears the console using system("cls") (system("clear") on POSIX).
 */
 static void clear_screen(void) {
+#ifdef _WIN32
     system("cls");
+#else
+    system("clear");
+#endif
 }
 
 /*
     press_any_key:
     Pauses execution until the user presses a key.
-    (void)_getch() explicitly ignores the returned key value.
+    (void)kbd_read(-1) explicitly ignores the returned key value.
 */
 static void press_any_key(void) {
     printf("\nPress any key...");
-    (void)_getch();
+    fflush(stdout);   /* No newline: a raw POSIX terminal would not show it yet */
+    (void)kbd_read(-1);
 }
 
 /*
@@ -63,53 +73,42 @@ static void print_menu(void) {
     puts("1) Game PvP");
     puts("2) Game vs AI (easy)");
     puts("3) Game vs AI (hard)");
-    puts("4) Score");
-    puts("5) Exit");
-    puts("\nChoose [1-5]...");
+    puts("4) Game vs AI (expert)");
+    puts("5) Score");
+    puts("6) Exit");
+    puts("\nChoose [1-6]...");
 }
 
 /*
     read_menu_choice:
-    Reads menu selection from keyboard using _getch().
+    Reads menu selection from keyboard using kbd_read().
     Returns:
-      - integer 1..5
+      - integer 1..MENU_EXIT (MENU_EXIT also when input ends)
 */
 static int read_menu_choice(void) {
     for (;;) {
-        int k = _getch();
-        if (k >= '1' && k <= '5') return (k - '0');
+        int k = kbd_read(-1);
+        if (k == KBD_CLOSED) return MENU_EXIT;
+        if (k >= '1' && k <= '0' + MENU_EXIT) return (k - '0');
     }
 }
 
 /* ------------------------- Board Ops ------------------------- */
 
-/*
-    board_reset:
-    Sets every cell in board to CELL_EMPTY (0).
-    Parameters:
-      b - game board array [ROWS][COLS]
-*/
-static void board_reset(int b[ROWS][COLS]) {
-    for (int r = 0; r < ROWS; r++) {
-        for (int c = 0; c < COLS; c++) {
-            b[r][c] = CELL_EMPTY;
-        }
-    }
-}
-
 /*
     board_print:
     Prints board with '.' for empty, 'X' for player 1, 'O' for player 2.
 */
-static void board_print(int b[ROWS][COLS]) {
+static void board_print(const board_t* b) {
     puts("");
     puts("  1 2 3 4 5 6 7");
     for (int r = 0; r < ROWS; r++) {
         putchar('|');
         for (int c = 0; c < COLS; c++) {
             char ch = '.';
-            if (b[r][c] == PLAYER_1) ch = 'X';
-            else if (b[r][c] == PLAYER_2) ch = 'O';
+            int cell = board_cell(b, r, c);
+            if (cell == PLAYER_1) ch = 'X';
+            else if (cell == PLAYER_2) ch = 'O';
             putchar(ch);
             putchar('|');
         }
@@ -119,72 +118,12 @@ static void board_print(int b[ROWS][COLS]) {
 }
 
 /*
-    col_full:
-    Returns 1 if column is full (top cell not empty), else 0.
+    Board state, chip dropping, win and draw detection live in Game_board.c:
+      - board_reset    empties the board
+      - board_drop     O(1) drop, returns landing row or -1 if the column is full
+      - board_has_won  shift-and-AND four-in-a-row test on the player's bitboard
+      - board_is_full  move counter reached ROWS * COLS
 */
-static int col_full(int b[ROWS][COLS], int col) {
-    return b[0][col] != CELL_EMPTY;
-}
-
-/*
-    drop_chip:
-    Drops chip into column:
-      - finds lowest empty cell in that column
-      - sets it to 'player'
-    Returns:
-      - landing row index (0..ROWS-1) on success
-      - -1 if column full
-*/
-static int drop_chip(int b[ROWS][COLS], int col, int player) {
-    for (int r = ROWS - 1; r >= 0; r--) {
-        if (b[r][col] == CELL_EMPTY) {
-            b[r][col] = player;
-            return r;
-        }
-    }
-    return -1;
-}
-
-/*
-    count_dir:
-    Counts consecutive pieces for player p in one direction (dr,dc)
-    starting adjacent to (r,c).
-*/
-static int count_dir(int b[ROWS][COLS], int r, int c, int dr, int dc, int p) {
-    int cnt = 0;
-    r += dr; c += dc;
-    while (r >= 0 && r < ROWS && c >= 0 && c < COLS && b[r][c] == p) {
-        cnt++;
-        r += dr; c += dc;
-    }
-    return cnt;
-}
-
-/*
-    check_win:
-    Checks whether last move at (r,c) by player p created 4-in-a-row.
-    Directions checked:
-      - horizontal, vertical, both diagonals
-    Returns 1 if win, else 0.
-*/
-static int check_win(int b[ROWS][COLS], int r, int c, int p) {
-    int h = 1 + count_dir(b, r, c, 0, -1, p) + count_dir(b, r, c, 0, 1, p);
-    int v = 1 + count_dir(b, r, c, -1, 0, p) + count_dir(b, r, c, 1, 0, p);
-    int d1 = 1 + count_dir(b, r, c, -1, -1, p) + count_dir(b, r, c, 1, 1, p);
-    int d2 = 1 + count_dir(b, r, c, -1, 1, p) + count_dir(b, r, c, 1, -1, p);
-    return (h >= 4 || v >= 4 || d1 >= 4 || d2 >= 4);
-}
-
-/*
-    check_draw:
-    Returns 1 if the board is full (no more moves), else 0.
-*/
-static int check_draw(int b[ROWS][COLS]) {
-    for (int c = 0; c < COLS; c++) {
-        if (b[0][c] == CELL_EMPTY) return 0;
-    }
-    return 1;
-}
 
 /* ------------------------- Game Input ------------------------- */
 
@@ -193,13 +132,14 @@ static int check_draw(int b[ROWS][COLS]) {
     Reads a single key and returns:
       - 0..6 if user pressed '1'..'7' (column index)
       - ACT_RESET if 'r'/'R'
-      - ACT_QUIT  if 'q'/'Q'
+      - ACT_QUIT  if 'q'/'Q' (or when input ends)
     Any other key is ignored (keeps waiting).
 */
 static int read_game_action(void) {
     for (;;) {
-        int k = _getch();
+        int k = kbd_read(-1);
 
+        if (k == KBD_CLOSED) return ACT_QUIT;
         if (k >= '1' && k <= '7') return (k - '1');
 
         switch (k) {
@@ -219,27 +159,15 @@ static int read_game_action(void) {
 
 /* ------------------------- AI ------------------------- */
 
-/*
-    landing_row_of:
-    Returns the row where a chip would land in column col without modifying board.
-    Returns -1 if full.
-*/
-static int landing_row_of(int b[ROWS][COLS], int col) {
-    for (int r = ROWS - 1; r >= 0; r--) {
-        if (b[r][col] == CELL_EMPTY) return r;
-    }
-    return -1;
-}
-
 /*
     ai_choose_easy:
     Random valid column.
 */
-static int ai_choose_easy(int b[ROWS][COLS]) {
-    for (;;) {
-        int c = rand() % COLS;
-        if (!col_full(b, c)) return c;
-    }
+static rng_t ai_rng;   /* Seeded once in main; unlike rand() it is private to this game */
+
+static int ai_choose_easy(const board_t* b) {
+    int c = rng_below(&ai_rng, COLS);   /* At most two draws, no retry loop on a nearly full board */
+    return board_can_play(b, c) ? c : rng_pick(&ai_rng, board_column_mask(b));
 }
 
 /*
@@ -247,48 +175,58 @@ static int ai_choose_easy(int b[ROWS][COLS]) {
     “Hard” AI heuristic:
       1) If AI can win in one move -> play it
       2) Else if human can win in one move -> block it
-      3) Else prefer center columns
+      3) Else prefer center columns, skipping cells right under a human threat
+    Both sides' winning cells come from one threat mask each (board_winning_moves).
 */
-static int ai_choose_hard(int b[ROWS][COLS], int ai_player) {
+static int ai_choose_hard(const board_t* b, int ai_player) {
     int human = (ai_player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+    bitboard_t safe;
 
     /* 1) win now */
-    for (int c = 0; c < COLS; c++) {
-        if (col_full(b, c)) continue;
-        int r = landing_row_of(b, c);
-        b[r][c] = ai_player;
-        if (check_win(b, r, c, ai_player)) { b[r][c] = CELL_EMPTY; return c; }
-        b[r][c] = CELL_EMPTY;
-    }
+    if (board_winning_moves(b, ai_player)) return board_move_column(board_winning_moves(b, ai_player));
 
     /* 2) block human */
-    for (int c = 0; c < COLS; c++) {
-        if (col_full(b, c)) continue;
-        int r = landing_row_of(b, c);
-        b[r][c] = human;
-        if (check_win(b, r, c, human)) { b[r][c] = CELL_EMPTY; return c; }
-        b[r][c] = CELL_EMPTY;
-    }
+    if (board_winning_moves(b, human)) return board_move_column(board_winning_moves(b, human));
 
     /* 3) center preference */
+    safe = board_safe_moves(b);
     {
         int pref[COLS] = { 3, 2, 4, 1, 5, 0, 6 };
         for (int i = 0; i < COLS; i++) {
             int c = pref[i];
-            if (!col_full(b, c)) return c;
+            if (safe & bitboard_column(c)) return c;
+        }
+        for (int i = 0; i < COLS; i++) {
+            int c = pref[i];
+            if (board_can_play(b, c)) return c;
         }
     }
 
     return ai_choose_easy(b);
 }
 
+/*
+    ai_tt:
+    Transposition table shared by every expert search (TT_DEFAULT_MB, allocated in main).
+*/
+static tt_t* ai_tt = NULL;
+
+/*
+    ai_choose_expert:
+    Negamax alpha-beta search (Game_search.c), deepened up to SEARCH_DEFAULT_DEPTH plies.
+*/
+static int ai_choose_expert(const board_t* b) {
+    search_params_t params = { SEARCH_DEFAULT_DEPTH, 0, 1, NULL, 0 };
+    return search_best_move(b, &params, ai_tt, NULL);
+}
+
 /* ------------------------- Game Core ------------------------- */
 
 /*
     play_game:
     Plays one round, but supports reset using an outer loop.
     Parameters:
-      mode  - MODE_PVP / MODE_AI_EASY / MODE_AI_HARD
+      mode  - MODE_PVP / MODE_AI_EASY / MODE_AI_HARD / MODE_AI_EXPERT
       score_p1 - pointer to Player1/You wins counter
       score_p2 - pointer to Player2/AI wins counter
       score_d  - pointer to draws counter
@@ -298,11 +236,11 @@ static int ai_choose_hard(int b[ROWS][COLS], int ai_player) {
       - R: reset board (restarts round, does not return to menu)
 */
 static void play_game(int mode, int* score_p1, int* score_p2, int* score_d) {
-    int b[ROWS][COLS];
+    board_t b;
     int player;
 
     for (;;) { /* outer loop: restart round on reset */
-        board_reset(b);
+        board_reset(&b);
         player = PLAYER_1;
 
         for (;;) { /* turn loop */
@@ -319,6 +257,9 @@ static void play_game(int mode, int* score_p1, int* score_p2, int* score_d) {
             case MODE_AI_HARD:
                 puts("Vs AI (hard) (You=X, AI=O)");
                 break;
+            case MODE_AI_EXPERT:
+                puts("Vs AI (expert) (You=X, AI=O)");
+                break;
             default:
                 puts("Unknown mode");
                 break;
@@ -330,7 +271,7 @@ static void play_game(int mode, int* score_p1, int* score_p2, int* score_d) {
             if (player == PLAYER_1) puts("Turn: Player 1 (X)");
             else puts(mode == MODE_PVP ? "Turn: Player 2 (O)" : "Turn: Computer (O)");
 
-            board_print(b);
+            board_print(&b);
 
             /* Decide the action/column */
             int action;
@@ -342,8 +283,13 @@ static void play_game(int mode, int* score_p1, int* score_p2, int* score_d) {
 
             case MODE_AI_EASY:
             case MODE_AI_HARD:
+            case MODE_AI_EXPERT:
                 if (player == PLAYER_2) {
-                    action = (mode == MODE_AI_HARD) ? ai_choose_hard(b, PLAYER_2) : ai_choose_easy(b);
+                    switch (mode) {
+                    case MODE_AI_EASY: action = ai_choose_easy(&b); break;
+                    case MODE_AI_HARD: action = ai_choose_hard(&b, PLAYER_2); break;
+                    default:           action = ai_choose_expert(&b); break;
+                    }
                 }
                 else {
                     action = read_game_action();
@@ -366,12 +312,12 @@ static void play_game(int mode, int* score_p1, int* score_p2, int* score_d) {
 
             default: {
                 int col = action;
-                int row = drop_chip(b, col, player);
+                int row = board_drop(&b, col, player);
                 if (row == -1) continue; /* full column */
 
-                if (check_win(b, row, col, player)) {
+                if (board_has_won(&b, player)) {
                     clear_screen();
-                    board_print(b);
+                    board_print(&b);
 
                     switch (mode) {
                     case MODE_PVP:
@@ -381,6 +327,7 @@ static void play_game(int mode, int* score_p1, int* score_p2, int* score_d) {
 
                     case MODE_AI_EASY:
                     case MODE_AI_HARD:
+                    case MODE_AI_EXPERT:
                         if (player == PLAYER_1) { puts("\nYou win!"); (*score_p1)++; }
                         else { puts("\nComputer wins!"); (*score_p2)++; }
                         break;
@@ -393,9 +340,9 @@ static void play_game(int mode, int* score_p1, int* score_p2, int* score_d) {
                     return;
                 }
 
-                if (check_draw(b)) {
+                if (board_is_full(&b)) {
                     clear_screen();
-                    board_print(b);
+                    board_print(&b);
                     puts("\nDraw.");
                     (*score_d)++;
                     press_any_key();
@@ -433,7 +380,9 @@ int main(void) {
     int score_p2 = 0;
     int score_d = 0;
 
-    srand((unsigned)time(NULL));
+    rng_seed(&ai_rng, (uint64_t)time(NULL));
+    kbd_init();                             /* Single keys without Enter on POSIX terminals */
+    ai_tt = tt_create(TT_DEFAULT_MB, 0);   /* NULL just means searching without a table */
 
     for (;;) {
         print_menu();
@@ -452,6 +401,10 @@ int main(void) {
             play_game(MODE_AI_HARD, &score_p1, &score_p2, &score_d);
             break;
 
+        case MENU_AI_EXPERT:
+            play_game(MODE_AI_EXPERT, &score_p1, &score_p2, &score_d);
+            break;
+
         case MENU_SCORE:
             show_score(score_p1, score_p2, score_d);
             break;
@@ -459,6 +412,7 @@ int main(void) {
         case MENU_EXIT:
             clear_screen();
             puts("Bye.");
+            tt_destroy(ai_tt);
             return 0;
 
         default: